@@ -0,0 +1,520 @@
+/*
+    Blocking Queue
+
+    Handing values between threads with addToList, removeFromListAtIndex(list, 0),
+    and a mutex and condition variable of your own, costs a lock round trip,
+    and a malloc and free, for every single value.
+
+    This queue keeps the nodes of a linked list, but it never frees them:
+
+     -  All Capacity nodes are allocated up front, and kept in a "Spare" chain.
+     -  Enqueueing takes a node from the spare chain, and links it to the tail.
+     -  Dequeueing unlinks the head node, and puts it back in the spare chain.
+
+    So once the queue is created, there is no allocation at all.
+
+    Consumers that can handle several values at once can use dequeueBatchFromQueue,
+    which takes as many values as they want (and are there) in one lock acquisition.
+
+    We also count how many threads are waiting on each condition, so we only
+    signal when somebody is actually waiting.
+
+    The queue has its own nodes instead of a LinkedList inside. A LinkedList's nodes
+    are private to LinkedList.c, and every addToList or removeFromListAtIndex also
+    keeps its cursor, Express Lane, Adaptive Storage, registry, and tracing up to date.
+    A queue needs none of that, it only ever touches the head and the tail, under
+    its own lock, so a singly linked chain is all it keeps (bench/BlockingQueueBench.c
+    compares it with a LinkedList behind a mutex).
+
+ */
+
+// For clock_gettime and pthread_condattr_setclock
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "BlockingQueue.h"
+
+/*
+
+    Node
+
+    Each node stores a void pointer to the value, and the next node.
+    Values only ever leave from the head, so it's a Singly Linked List.
+
+ */
+
+typedef struct Node {
+
+    // Pointer to the value
+    void *Value;
+
+    // Next Node
+    struct Node *Next;
+
+} Node;
+
+/*
+
+    Blocking Queue
+
+    This structure stores the queued nodes, the spare nodes,
+    and everything needed to wait for room or for values.
+
+ */
+
+struct BlockingQueue {
+
+    // The Top Node (dequeued next)
+    Node *Head;
+
+    // The End Node (enqueued last)
+    Node *Tail;
+
+    // Nodes not holding a value, ready to be used
+    Node *Spare;
+
+    // Size
+    int Size;
+
+    // Maximum Size
+    int Capacity;
+
+    // Guards everything above
+    pthread_mutex_t Lock;
+
+    // Signalled when a value is enqueued
+    pthread_cond_t NotEmpty;
+
+    // Signalled when a value is dequeued
+    pthread_cond_t NotFull;
+
+    // Number of threads waiting for a value
+    int WaitingConsumers;
+
+    // Number of threads waiting for room
+    int WaitingProducers;
+
+};
+
+
+/*
+
+  BlockingQueue *newBlockingQueue(int Capacity)
+
+  This function initializes a new BlockingQueue in heap memory,
+  allocates all its nodes, and returns the reference to it.
+
+*/
+
+BlockingQueue *newBlockingQueue(int Capacity) {
+
+    if (Capacity <= 0) {
+        printf("INVALID CAPACITY EXCEPTION. ATTEMPT TO CREATE QUEUE WITH CAPACITY %i\n", Capacity);
+        exit(-1);
+    }
+
+    BlockingQueue *queue = (BlockingQueue *) malloc(sizeof(struct BlockingQueue));
+
+    // Setting default values
+    queue->Head = NULL;
+    queue->Tail = NULL;
+    queue->Spare = NULL;
+    queue->Size = 0;
+    queue->Capacity = Capacity;
+    queue->WaitingConsumers = 0;
+    queue->WaitingProducers = 0;
+
+    // All the nodes we will ever need
+    for (int i = 0; i < Capacity; ++i) {
+        Node *node = (Node *) malloc(sizeof(struct Node));
+        node->Value = NULL;
+        node->Next = queue->Spare;
+        queue->Spare = node;
+    }
+
+    pthread_mutex_init(&queue->Lock, NULL);
+
+    // Timeouts are measured on the monotonic clock, so changing the system time doesn't affect them
+    pthread_condattr_t Attributes;
+    pthread_condattr_init(&Attributes);
+    pthread_condattr_setclock(&Attributes, CLOCK_MONOTONIC);
+
+    pthread_cond_init(&queue->NotEmpty, &Attributes);
+    pthread_cond_init(&queue->NotFull, &Attributes);
+
+    pthread_condattr_destroy(&Attributes);
+
+    return queue;
+}
+
+/*
+
+    int getQueueSize(BlockingQueue *queue)
+    - Returns the size of the queue
+
+ */
+
+int getQueueSize(BlockingQueue *queue) {
+
+    pthread_mutex_lock(&queue->Lock);
+
+    int Size = queue->Size;
+
+    pthread_mutex_unlock(&queue->Lock);
+
+    return Size;
+}
+
+/*
+
+    static struct timespec deadlineIn(long TimeoutMillis)
+
+    Returns the monotonic time TimeoutMillis from now.
+
+ */
+
+static struct timespec deadlineIn(long TimeoutMillis) {
+
+    struct timespec Deadline;
+
+    clock_gettime(CLOCK_MONOTONIC, &Deadline);
+
+    Deadline.tv_sec += TimeoutMillis / 1000;
+    Deadline.tv_nsec += (TimeoutMillis % 1000) * 1000000L;
+
+    if (Deadline.tv_nsec >= 1000000000L) {
+        Deadline.tv_sec++;
+        Deadline.tv_nsec -= 1000000000L;
+    }
+
+    return Deadline;
+}
+
+/*
+
+    static void push(BlockingQueue *queue, void *Value)
+
+    Takes a spare node, and links it to the tail.
+    The lock must be held, and the queue must not be full.
+
+ */
+
+static void push(BlockingQueue *queue, void *Value) {
+
+    // Take a spare node
+    Node *node = queue->Spare;
+    queue->Spare = node->Next;
+
+    node->Value = Value;
+    node->Next = NULL;
+
+    // Link it to the tail
+    if (queue->Tail == NULL)
+        queue->Head = node;
+    else
+        queue->Tail->Next = node;
+
+    queue->Tail = node;
+    queue->Size++;
+
+    // Wake up a consumer, if one is waiting
+    if (queue->WaitingConsumers > 0)
+        pthread_cond_signal(&queue->NotEmpty);
+}
+
+/*
+
+    static void *pop(BlockingQueue *queue)
+
+    Unlinks the head node, and gives it back to the spare nodes.
+    The lock must be held, and the queue must not be empty.
+    Waking up producers is left to the caller, so a batch only wakes them once.
+
+ */
+
+static void *pop(BlockingQueue *queue) {
+
+    // Unlink the head
+    Node *node = queue->Head;
+    queue->Head = node->Next;
+
+    if (queue->Head == NULL)
+        queue->Tail = NULL;
+
+    queue->Size--;
+
+    void *Value = node->Value;
+
+    // Recycle the node
+    node->Value = NULL;
+    node->Next = queue->Spare;
+    queue->Spare = node;
+
+    return Value;
+}
+
+/*
+
+    static void wakeProducers(BlockingQueue *queue, int Freed)
+
+    Wakes up producers waiting for room, now that Freed nodes are free.
+
+ */
+
+static void wakeProducers(BlockingQueue *queue, int Freed) {
+
+    if (queue->WaitingProducers == 0)
+        return;
+
+    if (Freed == 1)
+        pthread_cond_signal(&queue->NotFull);
+    else
+        pthread_cond_broadcast(&queue->NotFull);
+}
+
+/*
+
+    void enqueueToQueue(BlockingQueue *queue, void *Value)
+
+    Adds a value to the end of the queue, waits while the queue is full.
+
+ */
+
+void enqueueToQueue(BlockingQueue *queue, void *Value) {
+
+    pthread_mutex_lock(&queue->Lock);
+
+    while (queue->Size == queue->Capacity) {
+        queue->WaitingProducers++;
+        pthread_cond_wait(&queue->NotFull, &queue->Lock);
+        queue->WaitingProducers--;
+    }
+
+    push(queue, Value);
+
+    pthread_mutex_unlock(&queue->Lock);
+}
+
+/*
+
+    int tryEnqueueToQueue(BlockingQueue *queue, void *Value)
+
+    Adds a value to the end of the queue, if it isn't full.
+
+ */
+
+int tryEnqueueToQueue(BlockingQueue *queue, void *Value) {
+
+    pthread_mutex_lock(&queue->Lock);
+
+    int Added = queue->Size < queue->Capacity;
+
+    if (Added)
+        push(queue, Value);
+
+    pthread_mutex_unlock(&queue->Lock);
+
+    return Added;
+}
+
+/*
+
+    int timedEnqueueToQueue(BlockingQueue *queue, void *Value, long TimeoutMillis)
+
+    Adds a value to the end of the queue, waits at most TimeoutMillis while the queue is full.
+
+ */
+
+int timedEnqueueToQueue(BlockingQueue *queue, void *Value, long TimeoutMillis) {
+
+    struct timespec Deadline = deadlineIn(TimeoutMillis);
+
+    int TimedOut = 0;
+
+    pthread_mutex_lock(&queue->Lock);
+
+    while (queue->Size == queue->Capacity && !TimedOut) {
+        queue->WaitingProducers++;
+        TimedOut = pthread_cond_timedwait(&queue->NotFull, &queue->Lock, &Deadline) != 0;
+        queue->WaitingProducers--;
+    }
+
+    // There might have been room made just as we timed out
+    int Added = queue->Size < queue->Capacity;
+
+    if (Added)
+        push(queue, Value);
+
+    pthread_mutex_unlock(&queue->Lock);
+
+    return Added;
+}
+
+/*
+
+    void *dequeueFromQueue(BlockingQueue *queue)
+
+    Removes and returns the value at the start of the queue, waits while the queue is empty.
+
+ */
+
+void *dequeueFromQueue(BlockingQueue *queue) {
+
+    pthread_mutex_lock(&queue->Lock);
+
+    while (queue->Size == 0) {
+        queue->WaitingConsumers++;
+        pthread_cond_wait(&queue->NotEmpty, &queue->Lock);
+        queue->WaitingConsumers--;
+    }
+
+    void *Value = pop(queue);
+
+    wakeProducers(queue, 1);
+
+    pthread_mutex_unlock(&queue->Lock);
+
+    return Value;
+}
+
+/*
+
+    int tryDequeueFromQueue(BlockingQueue *queue, void **Value)
+
+    Removes the value at the start of the queue, if the queue isn't empty.
+
+ */
+
+int tryDequeueFromQueue(BlockingQueue *queue, void **Value) {
+
+    pthread_mutex_lock(&queue->Lock);
+
+    int Removed = queue->Size > 0;
+
+    if (Removed) {
+        *Value = pop(queue);
+        wakeProducers(queue, 1);
+    }
+
+    pthread_mutex_unlock(&queue->Lock);
+
+    return Removed;
+}
+
+/*
+
+    int timedDequeueFromQueue(BlockingQueue *queue, void **Value, long TimeoutMillis)
+
+    Removes the value at the start of the queue, waits at most TimeoutMillis while the queue is empty.
+
+ */
+
+int timedDequeueFromQueue(BlockingQueue *queue, void **Value, long TimeoutMillis) {
+
+    struct timespec Deadline = deadlineIn(TimeoutMillis);
+
+    int TimedOut = 0;
+
+    pthread_mutex_lock(&queue->Lock);
+
+    while (queue->Size == 0 && !TimedOut) {
+        queue->WaitingConsumers++;
+        TimedOut = pthread_cond_timedwait(&queue->NotEmpty, &queue->Lock, &Deadline) != 0;
+        queue->WaitingConsumers--;
+    }
+
+    // There might have been a value enqueued just as we timed out
+    int Removed = queue->Size > 0;
+
+    if (Removed) {
+        *Value = pop(queue);
+        wakeProducers(queue, 1);
+    }
+
+    pthread_mutex_unlock(&queue->Lock);
+
+    return Removed;
+}
+
+/*
+
+    int dequeueBatchFromQueue(BlockingQueue *queue, void **Destination, int Max)
+
+    Removes up to Max values from the start of the queue, in one lock acquisition.
+
+ */
+
+int dequeueBatchFromQueue(BlockingQueue *queue, void **Destination, int Max) {
+
+    if (Max <= 0)
+        return 0;
+
+    pthread_mutex_lock(&queue->Lock);
+
+    while (queue->Size == 0) {
+        queue->WaitingConsumers++;
+        pthread_cond_wait(&queue->NotEmpty, &queue->Lock);
+        queue->WaitingConsumers--;
+    }
+
+    // Take as many as we want, or as many as there are
+    int Count = 0;
+
+    while (Count < Max && queue->Size > 0)
+        Destination[Count++] = pop(queue);
+
+    wakeProducers(queue, Count);
+
+    pthread_mutex_unlock(&queue->Lock);
+
+    return Count;
+}
+
+/*
+
+    void deleteQueue(BlockingQueue *queue)
+
+    Frees the values still in the queue, all the nodes,
+    and deletes the queue.
+
+ */
+
+void deleteQueue(BlockingQueue *queue) {
+
+    // To store reference to next node
+    Node *NextNode;
+
+    // Queued nodes, with their values
+    Node *curNode = queue->Head;
+
+    while (curNode != NULL) {
+        NextNode = curNode->Next;
+
+        // GC Data Stored in the Node
+        free(curNode->Value);
+
+        // GC Node
+        free(curNode);
+
+        curNode = NextNode;
+    }
+
+    // Spare nodes, no values
+    curNode = queue->Spare;
+
+    while (curNode != NULL) {
+        NextNode = curNode->Next;
+        free(curNode);
+        curNode = NextNode;
+    }
+
+    pthread_cond_destroy(&queue->NotEmpty);
+    pthread_cond_destroy(&queue->NotFull);
+    pthread_mutex_destroy(&queue->Lock);
+
+    free(queue);
+}
@@ -0,0 +1,144 @@
+#ifndef BLOCKINGQUEUE_H
+#define BLOCKINGQUEUE_H
+
+/*
+
+    Blocking Queue
+
+    A bounded, thread safe, first in first out queue, for handing values
+    from producer threads to consumer threads.
+
+    - Enqueue adds to the end, dequeue removes from the start.
+    - The queue holds at most Capacity values, enqueueing on a full queue
+      waits until there's room, dequeueing on an empty queue waits until
+      there's a value.
+    - All the nodes are allocated when the queue is created, and recycled
+      after that, so enqueueing and dequeueing never allocate.
+
+ */
+
+// Blocking Queue Data Type
+typedef struct BlockingQueue BlockingQueue;
+
+/*
+
+    BlockingQueue *newBlockingQueue(int Capacity)
+
+    - To construct the queue, holding at most Capacity values.
+    - Returns reference to the newly
+      created queue.
+    - O(Capacity) Time, O(Capacity) Space
+
+ */
+
+BlockingQueue *newBlockingQueue(int Capacity);
+
+/*
+
+    int getQueueSize(BlockingQueue *queue)
+
+    - Returns the number of values in the queue.
+
+ */
+
+int getQueueSize(BlockingQueue *queue);
+
+/*
+
+    void enqueueToQueue(BlockingQueue *queue, void *Value)
+
+    - Adds a value to the end of the queue, waits while the queue is full.
+    - O(1) Time, O(1) Space
+
+ */
+
+void enqueueToQueue(BlockingQueue *queue, void *Value);
+
+/*
+
+    int tryEnqueueToQueue(BlockingQueue *queue, void *Value)
+
+    - Adds a value to the end of the queue, if it isn't full.
+    - Returns non - zero if the value was added, zero if the queue was full.
+    - O(1) Time, O(1) Space
+
+ */
+
+int tryEnqueueToQueue(BlockingQueue *queue, void *Value);
+
+/*
+
+    int timedEnqueueToQueue(BlockingQueue *queue, void *Value, long TimeoutMillis)
+
+    - Adds a value to the end of the queue, waits at most TimeoutMillis while the queue is full.
+    - Returns non - zero if the value was added, zero if it timed out.
+    - O(1) Time, O(1) Space
+
+ */
+
+int timedEnqueueToQueue(BlockingQueue *queue, void *Value, long TimeoutMillis);
+
+/*
+
+    void *dequeueFromQueue(BlockingQueue *queue)
+
+    - Removes and returns the value at the start of the queue, waits while the queue is empty.
+    - O(1) Time, O(1) Space
+
+ */
+
+void *dequeueFromQueue(BlockingQueue *queue);
+
+/*
+
+    int tryDequeueFromQueue(BlockingQueue *queue, void **Value)
+
+    - Removes the value at the start of the queue and assigns it to *Value, if the queue isn't empty.
+    - Returns non - zero if a value was removed, zero if the queue was empty.
+    - O(1) Time, O(1) Space
+
+ */
+
+int tryDequeueFromQueue(BlockingQueue *queue, void **Value);
+
+/*
+
+    int timedDequeueFromQueue(BlockingQueue *queue, void **Value, long TimeoutMillis)
+
+    - Removes the value at the start of the queue and assigns it to *Value,
+      waits at most TimeoutMillis while the queue is empty.
+    - Returns non - zero if a value was removed, zero if it timed out.
+    - O(1) Time, O(1) Space
+
+ */
+
+int timedDequeueFromQueue(BlockingQueue *queue, void **Value, long TimeoutMillis);
+
+/*
+
+    int dequeueBatchFromQueue(BlockingQueue *queue, void **Destination, int Max)
+
+    - Removes up to Max values from the start of the queue in one go, and stores
+      them in Destination, in order. Waits while the queue is empty.
+    - Returns the number of values removed (at least 1, if Max is at least 1).
+    - Takes the lock once for the whole batch.
+    - O(Max) Time, O(1) Space
+
+ */
+
+int dequeueBatchFromQueue(BlockingQueue *queue, void **Destination, int Max);
+
+/*
+
+    void deleteQueue(BlockingQueue *queue)
+
+    - Frees the values still in the queue, and deletes the queue.
+    - No thread may be using the queue anymore.
+    - O(Capacity) Time, O(1) Space
+
+ */
+
+void deleteQueue(BlockingQueue *queue);
+
+
+#endif
@@ -0,0 +1,641 @@
+/*
+    Concurrent Linked List
+
+    Config tables, routing tables, and the like are read by a lot of threads,
+    and are changed once in a blue moon. The regular LinkedList can't be read by
+    two threads at once, because reading moves the shared "Cursor", and removing
+    frees the node straight away, so every read would need a global lock.
+
+    This variant fixes that:
+
+     -  There is only ONE writer. The writer links new nodes in completely first,
+        and only then publishes them (release store of the pointer that leads to them).
+        Readers follow pointers with acquire loads, so whatever they reach is complete.
+
+     -  Each reader carries its own cursor in its ConcurrentListReader, so reading
+        never writes to the shared list.
+
+     -  Removed nodes are unlinked, but not freed, because a reader might be standing
+        on them. Instead they are "retired" with the current epoch, and the epoch is bumped.
+        A reader announces the epoch it started reading in. A retired node can only be
+        freed once every active reader announced an epoch that is newer than the node's,
+        because those readers started after the node was unlinked, and can't reach it.
+
+    Unlinking a node never touches the node's own Next pointer, so a reader standing
+    on a removed node still walks back into the list.
+
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+
+#include "ConcurrentList.h"
+
+// Free retired nodes once this many are waiting
+#define RECLAIM_THRESHOLD 64
+
+// Size of a cache line, to keep readers from sharing one
+#define CACHE_LINE 64
+
+/*
+
+    Node
+
+    Each node stores a void pointer to the value, and the next node.
+
+    Readers only ever move forwards, so unlike the LinkedList this is
+    a Singly Linked List.
+
+    Retired nodes are chained together through "Retired", and remember
+    the epoch they were retired in.
+
+ */
+
+typedef struct Node {
+
+    // Pointer to the value
+    void *Value;
+
+    // Next Node (read by readers, so it's atomic)
+    _Atomic(struct Node *) Next;
+
+    // Next Retired Node
+    struct Node *Retired;
+
+    // Epoch in which the node was retired
+    unsigned long RetireEpoch;
+
+} Node;
+
+/*
+
+    Reader Slot
+
+    Every registered reader owns one slot. Epoch is zero while the reader
+    is not reading, otherwise it's the epoch the reader started in.
+
+    Each slot gets its own cache line, so readers don't slow each other down.
+
+ */
+
+typedef struct ReaderSlot {
+
+    // Epoch the reader started reading in, zero when not reading
+    _Alignas(CACHE_LINE) atomic_ulong Epoch;
+
+    // Non - zero if a reader owns this slot
+    atomic_int InUse;
+
+} ReaderSlot;
+
+/*
+
+    Concurrent Linked List
+
+    Head and Size are read by the readers, the rest only by the writer.
+
+ */
+
+struct ConcurrentList {
+
+    // The Top Node
+    _Atomic(Node *) Head;
+
+    // The End Node (writer only)
+    Node *Tail;
+
+    // Size
+    atomic_int Size;
+
+    // Current Epoch
+    _Alignas(CACHE_LINE) atomic_ulong Epoch;
+
+    // Oldest Retired Node (writer only)
+    Node *RetiredHead;
+
+    // Newest Retired Node (writer only)
+    Node *RetiredTail;
+
+    // Number of Retired Nodes waiting to be freed (writer only)
+    int RetiredCount;
+
+    // One slot for every reader
+    ReaderSlot Slots[CONCURRENT_LIST_MAX_READERS];
+
+};
+
+/*
+
+    Concurrent List Reader
+
+    Holds the reader's slot, and its own cursor.
+
+ */
+
+struct ConcurrentListReader {
+
+    // The list being read
+    ConcurrentList *List;
+
+    // The reader's slot in the list
+    ReaderSlot *Slot;
+
+    // Index of the node at the cursor
+    int Cursor;
+
+    // Node at the cursor, NULL once past the end
+    Node *NodeAtCursor;
+
+};
+
+
+/*
+
+  ConcurrentList *newConcurrentList()
+
+  This function initializes a new ConcurrentList in heap memory,
+  and returns the reference to it.
+
+*/
+
+ConcurrentList *newConcurrentList() {
+
+    // aligned_alloc wants the size to be a multiple of the alignment
+    size_t Bytes = (sizeof(ConcurrentList) + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+
+    ConcurrentList *list = (ConcurrentList *) aligned_alloc(CACHE_LINE, Bytes);
+
+    // Setting default values
+    atomic_init(&list->Head, NULL);
+    list->Tail = NULL;
+    atomic_init(&list->Size, 0);
+
+    // Epoch starts at 1, because 0 means "not reading"
+    atomic_init(&list->Epoch, 1);
+
+    list->RetiredHead = NULL;
+    list->RetiredTail = NULL;
+    list->RetiredCount = 0;
+
+    for (int i = 0; i < CONCURRENT_LIST_MAX_READERS; ++i) {
+        atomic_init(&list->Slots[i].Epoch, 0);
+        atomic_init(&list->Slots[i].InUse, 0);
+    }
+
+    return list;
+}
+
+/*
+
+    int getConcurrentListSize(ConcurrentList *list)
+    - Returns the size of the list
+
+ */
+
+int getConcurrentListSize(ConcurrentList *list) {
+    return atomic_load_explicit(&list->Size, memory_order_acquire);
+}
+
+/*
+
+    static Node *newNode(void *Value)
+
+    Initializes a new node in heap memory. The node is not
+    published until the writer links it in.
+
+ */
+
+static Node *newNode(void *Value) {
+
+    Node *node = (Node *) malloc(sizeof(struct Node));
+
+    node->Value = Value;
+    atomic_init(&node->Next, NULL);
+    node->Retired = NULL;
+    node->RetireEpoch = 0;
+
+    return node;
+}
+
+/*
+
+    static Node *getBefore(ConcurrentList *list, int Index)
+
+    Returns the node just before the given index. Only the writer
+    calls this, and only the writer changes the links, so relaxed
+    loads are enough here.
+
+ */
+
+static Node *getBefore(ConcurrentList *list, int Index) {
+
+    Node *curNode = atomic_load_explicit(&list->Head, memory_order_relaxed);
+
+    for (int i = 0; i < Index - 1; ++i)
+        curNode = atomic_load_explicit(&curNode->Next, memory_order_relaxed);
+
+    return curNode;
+}
+
+/*
+
+    void addToConcurrentList(ConcurrentList *list, void *Value)
+
+    Adds the value to the end of the list. The node is completely
+    initialised before the release store that publishes it.
+
+ */
+
+void addToConcurrentList(ConcurrentList *list, void *Value) {
+
+    Node *node = newNode(Value);
+
+    // If it's the first element, publish it as the head
+    if (list->Tail == NULL)
+        atomic_store_explicit(&list->Head, node, memory_order_release);
+
+        // Else publish it after the tail
+    else
+        atomic_store_explicit(&list->Tail->Next, node, memory_order_release);
+
+    list->Tail = node;
+
+    atomic_fetch_add_explicit(&list->Size, 1, memory_order_release);
+}
+
+/*
+
+    void addToConcurrentListAtIndex(ConcurrentList *list, void *Value, int Index)
+
+    Adds a new element to the list at a given index.
+
+ */
+
+void addToConcurrentListAtIndex(ConcurrentList *list, void *Value, int Index) {
+
+    int Size = atomic_load_explicit(&list->Size, memory_order_relaxed);
+
+    if (Index < 0 || Index >= Size) {
+        printf("INDEX OUT OF BOUNDS EXCEPTION. ATTEMPT TO INDEX INVALID INDEX %i\n", Index);
+        exit(-1);
+    }
+
+    Node *node = newNode(Value);
+
+    // If Index is 0, the new node becomes the head
+    if (Index == 0) {
+
+        // Link the new node to the old head first...
+        atomic_store_explicit(&node->Next, atomic_load_explicit(&list->Head, memory_order_relaxed),
+                              memory_order_relaxed);
+
+        // ...then publish it
+        atomic_store_explicit(&list->Head, node, memory_order_release);
+
+    }
+
+        // Else the new node goes between NodeBefore and the node at Index
+    else {
+
+        Node *NodeBefore = getBefore(list, Index);
+
+        // Link the new node to the node at Index first...
+        atomic_store_explicit(&node->Next, atomic_load_explicit(&NodeBefore->Next, memory_order_relaxed),
+                              memory_order_relaxed);
+
+        // ...then publish it
+        atomic_store_explicit(&NodeBefore->Next, node, memory_order_release);
+
+    }
+
+    atomic_fetch_add_explicit(&list->Size, 1, memory_order_release);
+}
+
+/*
+
+    static void retire(ConcurrentList *list, Node *node)
+
+    Retires an unlinked node with the current epoch, and moves
+    on to the next epoch. Readers that start from now on can't
+    reach the node anymore.
+
+ */
+
+static void retire(ConcurrentList *list, Node *node) {
+
+    node->RetireEpoch = atomic_fetch_add_explicit(&list->Epoch, 1, memory_order_seq_cst);
+    node->Retired = NULL;
+
+    if (list->RetiredTail == NULL)
+        list->RetiredHead = node;
+    else
+        list->RetiredTail->Retired = node;
+
+    list->RetiredTail = node;
+    list->RetiredCount++;
+}
+
+/*
+
+    void removeFromConcurrentListAtIndex(ConcurrentList *list, int Index)
+
+    Unlinks the node from the list, and retires it.
+
+ */
+
+void removeFromConcurrentListAtIndex(ConcurrentList *list, int Index) {
+
+    int Size = atomic_load_explicit(&list->Size, memory_order_relaxed);
+
+    if (Index < 0 || Index >= Size) {
+        printf("INDEX OUT OF BOUNDS EXCEPTION. ATTEMPT TO INDEX INVALID INDEX %i\n", Index);
+        exit(-1);
+    }
+
+    Node *ToRemove = NULL;
+
+    // If it's the head node, the node after it becomes the head
+    if (Index == 0) {
+
+        ToRemove = atomic_load_explicit(&list->Head, memory_order_relaxed);
+
+        atomic_store_explicit(&list->Head, atomic_load_explicit(&ToRemove->Next, memory_order_relaxed),
+                              memory_order_release);
+
+        if (list->Tail == ToRemove)
+            list->Tail = NULL;
+
+    }
+
+        // Else the node before it skips over it
+    else {
+
+        Node *Before = getBefore(list, Index);
+
+        ToRemove = atomic_load_explicit(&Before->Next, memory_order_relaxed);
+
+        // ToRemove's own Next is left alone, readers standing on it still get back into the list
+        atomic_store_explicit(&Before->Next, atomic_load_explicit(&ToRemove->Next, memory_order_relaxed),
+                              memory_order_release);
+
+        if (list->Tail == ToRemove)
+            list->Tail = Before;
+
+    }
+
+    atomic_fetch_sub_explicit(&list->Size, 1, memory_order_release);
+
+    retire(list, ToRemove);
+
+    if (list->RetiredCount >= RECLAIM_THRESHOLD)
+        reclaimConcurrentList(list);
+}
+
+/*
+
+    void reclaimConcurrentList(ConcurrentList *list)
+
+    Finds the oldest epoch any reader is still reading in, and frees
+    every retired node that was retired before it.
+
+    The unlinking stores are only release stores, so on their own they could
+    still be on their way to a reader while we look at its slot. The fence pairs
+    with the one in beginConcurrentListRead: either we see the reader's slot,
+    or the reader sees the list without the nodes we are about to free.
+
+ */
+
+void reclaimConcurrentList(ConcurrentList *list) {
+
+    // Every unlink so far, before any slot is read
+    atomic_thread_fence(memory_order_seq_cst);
+
+    // Everything can go if nobody is reading
+    unsigned long OldestEpoch = atomic_load_explicit(&list->Epoch, memory_order_seq_cst);
+
+    for (int i = 0; i < CONCURRENT_LIST_MAX_READERS; ++i) {
+
+        unsigned long Epoch = atomic_load_explicit(&list->Slots[i].Epoch, memory_order_seq_cst);
+
+        if (Epoch != 0 && Epoch < OldestEpoch)
+            OldestEpoch = Epoch;
+    }
+
+    // Retired nodes are in epoch order, so free from the front until one is still visible
+    while (list->RetiredHead != NULL && list->RetiredHead->RetireEpoch < OldestEpoch) {
+
+        Node *NextRetired = list->RetiredHead->Retired;
+
+        free(list->RetiredHead);
+
+        list->RetiredHead = NextRetired;
+        list->RetiredCount--;
+    }
+
+    if (list->RetiredHead == NULL)
+        list->RetiredTail = NULL;
+}
+
+/*
+
+    void deleteConcurrentList(ConcurrentList *list)
+
+    Completely clears all the elements in the list,
+    and deletes the list. No reader may be left.
+
+*/
+
+void deleteConcurrentList(ConcurrentList *list) {
+
+    // Get first node
+    Node *curNode = atomic_load_explicit(&list->Head, memory_order_relaxed);
+
+    // To store reference to next node
+    Node *NextNode;
+
+    while (curNode != NULL) {
+        NextNode = atomic_load_explicit(&curNode->Next, memory_order_relaxed);
+
+        // GC Data Stored in the Node
+        free(curNode->Value);
+
+        // GC Node
+        free(curNode);
+
+        curNode = NextNode;
+    }
+
+    // Retired nodes no longer hold values of the list, only the nodes go
+    curNode = list->RetiredHead;
+
+    while (curNode != NULL) {
+        NextNode = curNode->Retired;
+        free(curNode);
+        curNode = NextNode;
+    }
+
+    free(list);
+}
+
+/*
+
+    ConcurrentListReader *newConcurrentListReader(ConcurrentList *list)
+
+    Claims a free slot for the new reader.
+
+ */
+
+ConcurrentListReader *newConcurrentListReader(ConcurrentList *list) {
+
+    for (int i = 0; i < CONCURRENT_LIST_MAX_READERS; ++i) {
+
+        int Free = 0;
+
+        if (atomic_compare_exchange_strong(&list->Slots[i].InUse, &Free, 1)) {
+
+            ConcurrentListReader *reader = (ConcurrentListReader *) malloc(sizeof(struct ConcurrentListReader));
+
+            reader->List = list;
+            reader->Slot = &list->Slots[i];
+            reader->Cursor = 0;
+            reader->NodeAtCursor = NULL;
+
+            return reader;
+        }
+    }
+
+    // No free slot left
+    return NULL;
+}
+
+/*
+
+    void deleteConcurrentListReader(ConcurrentListReader *reader)
+
+    Gives the reader's slot back, and deletes the reader.
+
+ */
+
+void deleteConcurrentListReader(ConcurrentListReader *reader) {
+
+    atomic_store_explicit(&reader->Slot->Epoch, 0, memory_order_release);
+    atomic_store_explicit(&reader->Slot->InUse, 0, memory_order_release);
+
+    free(reader);
+}
+
+/*
+
+    void beginConcurrentListRead(ConcurrentListReader *reader)
+
+    Announces the current epoch in the reader's slot, and only then
+    loads the head. The fence between the two pairs with the one in
+    reclaimConcurrentList, and both are seq_cst, so they are in one total order:
+    if the writer's fence came first, our head load sees every unlink before it,
+    and we can't reach anything it frees. If ours came first, the writer's slot
+    scan sees our epoch, and keeps every node retired since.
+
+ */
+
+void beginConcurrentListRead(ConcurrentListReader *reader) {
+
+    ConcurrentList *list = reader->List;
+
+    unsigned long Epoch = atomic_load_explicit(&list->Epoch, memory_order_seq_cst);
+
+    atomic_store_explicit(&reader->Slot->Epoch, Epoch, memory_order_seq_cst);
+
+    // The announcement, before the head
+    atomic_thread_fence(memory_order_seq_cst);
+
+    reader->Cursor = 0;
+    reader->NodeAtCursor = atomic_load_explicit(&list->Head, memory_order_acquire);
+}
+
+/*
+
+    int nextFromConcurrentList(ConcurrentListReader *reader, void **Value)
+
+    Hands out the value at the reader's cursor, and moves the cursor forward.
+
+ */
+
+int nextFromConcurrentList(ConcurrentListReader *reader, void **Value) {
+
+    Node *curNode = reader->NodeAtCursor;
+
+    if (curNode == NULL)
+        return 0;
+
+    *Value = curNode->Value;
+
+    reader->NodeAtCursor = atomic_load_explicit(&curNode->Next, memory_order_acquire);
+    reader->Cursor++;
+
+    return 1;
+}
+
+/*
+
+    void *getFromConcurrentList(ConcurrentListReader *reader, int Index)
+
+    Readers can only move forwards, so if the index is behind the
+    reader's cursor, we start again from the head.
+
+ */
+
+void *getFromConcurrentList(ConcurrentListReader *reader, int Index) {
+
+    if (Index < reader->Cursor || reader->NodeAtCursor == NULL) {
+        reader->Cursor = 0;
+        reader->NodeAtCursor = atomic_load_explicit(&reader->List->Head, memory_order_acquire);
+    }
+
+    // Move forwards until we reach the index, or fall off the end
+    while (reader->NodeAtCursor != NULL && reader->Cursor < Index) {
+        reader->NodeAtCursor = atomic_load_explicit(&reader->NodeAtCursor->Next, memory_order_acquire);
+        reader->Cursor++;
+    }
+
+    if (reader->NodeAtCursor == NULL)
+        return NULL;
+
+    return reader->NodeAtCursor->Value;
+}
+
+/*
+
+    void endConcurrentListRead(ConcurrentListReader *reader)
+
+    Tells the writer we are no longer looking at anything.
+
+ */
+
+void endConcurrentListRead(ConcurrentListReader *reader) {
+
+    reader->NodeAtCursor = NULL;
+    reader->Cursor = 0;
+
+    atomic_store_explicit(&reader->Slot->Epoch, 0, memory_order_release);
+}
+
+/*
+
+    void forEachElementInConcurrentList(ConcurrentListReader *reader, void(*f)(void*))
+
+    Apply the function f to the elements of the list, inside its own read.
+
+ */
+
+void forEachElementInConcurrentList(ConcurrentListReader *reader, void(*f)(void *)) {
+
+    void *Value = NULL;
+
+    beginConcurrentListRead(reader);
+
+    while (nextFromConcurrentList(reader, &Value))
+        f(Value);
+
+    endConcurrentListRead(reader);
+}
@@ -0,0 +1,197 @@
+#ifndef CONCURRENTLIST_H
+#define CONCURRENTLIST_H
+
+/*
+
+    Concurrent Linked List
+
+    A single writer / multi reader variant of the LinkedList.
+
+    - Exactly ONE thread may call the writer functions (add, remove, reclaim).
+    - Any number of threads may read at the same time, without locks, each
+      through its own ConcurrentListReader.
+    - Removed nodes are not freed straight away, they are retired and freed
+      once no reader can still be looking at them (epoch based reclamation).
+
+ */
+
+// Concurrent Linked List Data Type
+typedef struct ConcurrentList ConcurrentList;
+
+// Per Thread Reader, holds the reader's own cursor
+typedef struct ConcurrentListReader ConcurrentListReader;
+
+// Maximum number of readers that can be registered at the same time
+#define CONCURRENT_LIST_MAX_READERS 128
+
+/*
+
+    ConcurrentList *newConcurrentList()
+
+    - To construct the concurrent list.
+    - Returns reference to the newly
+      created list.
+
+ */
+
+ConcurrentList *newConcurrentList();
+
+/*
+
+    int getConcurrentListSize(ConcurrentList *list)
+
+    - Returns Size of List
+    - Safe to call from any thread.
+
+ */
+
+int getConcurrentListSize(ConcurrentList *list);
+
+/*
+
+    void addToConcurrentList(ConcurrentList *list, void *Value)
+
+    - WRITER ONLY.
+    - Adds a new value to the end of the list, and publishes it to the readers.
+    - O(1) Time, O(1) Space
+
+ */
+
+void addToConcurrentList(ConcurrentList *list, void *Value);
+
+/*
+
+    void addToConcurrentListAtIndex(ConcurrentList *list, void *Value, int Index)
+
+    - WRITER ONLY.
+    - Adds a new element to the list at a given index.
+    - O(1) to O(n) Time, O(1) Space
+
+ */
+
+void addToConcurrentListAtIndex(ConcurrentList *list, void *Value, int Index);
+
+/*
+
+    void removeFromConcurrentListAtIndex(ConcurrentList *list, int Index)
+
+    - WRITER ONLY.
+    - Removes a value from the list. The node is retired, and freed
+      once every reader that could still see it has finished reading.
+    - The value itself is NOT freed, just like removeFromListAtIndex.
+    - O(1) to O(n) Time, O(1) Space
+
+ */
+
+void removeFromConcurrentListAtIndex(ConcurrentList *list, int Index);
+
+/*
+
+    void reclaimConcurrentList(ConcurrentList *list)
+
+    - WRITER ONLY.
+    - Frees every retired node that no reader can see anymore.
+    - Removing nodes already does this every now and then, call it
+      yourself if you want the memory back sooner.
+
+ */
+
+void reclaimConcurrentList(ConcurrentList *list);
+
+/*
+
+    void deleteConcurrentList(ConcurrentList *list)
+
+    - Completely clears all the elements in the list (values included),
+      and deletes the list.
+    - All readers MUST be deleted before calling this.
+    - O(n) Time, O(1) Space
+
+ */
+
+void deleteConcurrentList(ConcurrentList *list);
+
+/*
+
+    ConcurrentListReader *newConcurrentListReader(ConcurrentList *list)
+
+    - Registers a new reader. Each reading thread needs its own reader.
+    - Returns NULL if CONCURRENT_LIST_MAX_READERS readers are already registered.
+
+ */
+
+ConcurrentListReader *newConcurrentListReader(ConcurrentList *list);
+
+/*
+
+    void deleteConcurrentListReader(ConcurrentListReader *reader)
+
+    - Unregisters the reader, and deletes it.
+
+ */
+
+void deleteConcurrentListReader(ConcurrentListReader *reader);
+
+/*
+
+    void beginConcurrentListRead(ConcurrentListReader *reader)
+
+    - Starts a read, and moves the reader's cursor to the start of the list.
+    - Values and nodes seen between begin and end stay valid until end is called.
+    - O(1) Time, O(1) Space
+
+ */
+
+void beginConcurrentListRead(ConcurrentListReader *reader);
+
+/*
+
+    int nextFromConcurrentList(ConcurrentListReader *reader, void **Value)
+
+    - Assigns *Value the value at the reader's cursor, and moves the cursor forward.
+    - Returns zero once the end of the list has been reached, non - zero otherwise.
+    - Must be called between beginConcurrentListRead and endConcurrentListRead.
+    - O(1) Time, O(1) Space
+
+ */
+
+int nextFromConcurrentList(ConcurrentListReader *reader, void **Value);
+
+/*
+
+    void *getFromConcurrentList(ConcurrentListReader *reader, int Index)
+
+    - Returns a value from the list found at provided index, or NULL if the
+      list has become shorter than Index.
+    - Starts from the reader's cursor when moving forward, from the head otherwise.
+    - Must be called between beginConcurrentListRead and endConcurrentListRead.
+    - O(1) to O(n) Time, O(1) Space
+
+ */
+
+void *getFromConcurrentList(ConcurrentListReader *reader, int Index);
+
+/*
+
+    void endConcurrentListRead(ConcurrentListReader *reader)
+
+    - Finishes a read. Values and nodes seen during the read may now be reclaimed.
+    - O(1) Time, O(1) Space
+
+ */
+
+void endConcurrentListRead(ConcurrentListReader *reader);
+
+/*
+
+    void forEachElementInConcurrentList(ConcurrentListReader *reader, void(*f)(void*))
+
+    - Apply the function f to the elements of the list, inside its own read.
+    - O(n) Time, O(1) Space
+
+ */
+
+void forEachElementInConcurrentList(ConcurrentListReader *reader, void(*f)(void *));
+
+
+#endif
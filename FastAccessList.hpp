@@ -0,0 +1,738 @@
+#ifndef FASTACCESSLIST_HPP
+#define FASTACCESSLIST_HPP
+
+/*
+
+    Fast Access List for C++
+
+    A header only, type safe version of the Fast Access Linked List, for C++17.
+
+    It's the same design as LinkedList.c: a doubly linked list of nodes, and a
+    "Cursor" and "NodeAtCursor" caching the last node accessed by index, so
+    operator[] starts from whichever of head, tail, or cursor is closest.
+
+    But instead of void pointers it stores T's inside the nodes, so there's
+    no casting, the compiler can inline everything, and std:: algorithms work
+    through its bidirectional iterators.
+
+    - Elements can be move only (std::unique_ptr and the like).
+    - Nodes (and elements that want one) get their memory from Alloc,
+      so std::pmr::polymorphic_allocator works, see fast_access_pmr::fast_access_list.
+    - For small, trivially copyable T, const operator[] returns the element by value,
+      picked at compile time.
+    - Const access never moves the cursor, so a list nobody is changing can be
+      read from many threads at once.
+
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+template<typename T, typename Alloc = std::allocator<T>>
+class fast_access_list {
+
+public:
+
+    using value_type = T;
+    using allocator_type = Alloc;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using pointer = T *;
+    using const_pointer = const T *;
+
+    /*
+
+        index_result
+
+        What const operator[] returns. Small trivially copyable elements are
+        returned by value, so they can stay in a register, instead of being
+        read through a reference into the node again.
+
+     */
+
+    using index_result = std::conditional_t<std::is_trivially_copyable_v<T> && sizeof(T) <= 2 * sizeof(void *),
+            T, const T &>;
+
+private:
+
+    /*
+
+        Node Base
+
+        The links of a node. The list itself holds one of these as a "sentinel",
+        which comes after the tail and before the head, so end() is a real
+        position, and --end() gives the tail.
+
+     */
+
+    struct node_base {
+
+        // Next Node (the sentinel after the tail)
+        node_base *next;
+
+        // Last Node (the sentinel before the head)
+        node_base *last;
+
+    };
+
+    /*
+
+        Node
+
+        The links, and room for one element. The element is constructed
+        and destroyed through Alloc, separately from the node.
+
+     */
+
+    struct node : node_base {
+
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T *value() noexcept { return std::launder(reinterpret_cast<T *>(storage)); }
+
+    };
+
+    using value_traits = std::allocator_traits<Alloc>;
+    using node_allocator = typename value_traits::template rebind_alloc<node>;
+    using node_traits = std::allocator_traits<node_allocator>;
+
+    static_assert(std::is_same_v<typename node_traits::pointer, node *>, "fancy pointers are not supported");
+
+    // Index meaning "don't know"
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+public:
+
+    /*
+
+        Iterators
+
+        Bidirectional, they walk the links, and never touch the cursor.
+
+     */
+
+    template<bool Const>
+    class basic_iterator {
+
+        friend class fast_access_list;
+
+        template<bool> friend
+        class basic_iterator;
+
+        node_base *node_ = nullptr;
+
+        explicit basic_iterator(node_base *n) noexcept: node_(n) {}
+
+    public:
+
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T *, T *>;
+        using reference = std::conditional_t<Const, const T &, T &>;
+
+        basic_iterator() noexcept = default;
+
+        // iterator converts to const_iterator
+        template<bool C = Const, typename = std::enable_if_t<C>>
+        basic_iterator(const basic_iterator<false> &other) noexcept : node_(other.node_) {}
+
+        reference operator*() const noexcept { return *static_cast<node *>(node_)->value(); }
+
+        pointer operator->() const noexcept { return static_cast<node *>(node_)->value(); }
+
+        basic_iterator &operator++() noexcept {
+            node_ = node_->next;
+            return *this;
+        }
+
+        basic_iterator operator++(int) noexcept {
+            basic_iterator before = *this;
+            node_ = node_->next;
+            return before;
+        }
+
+        basic_iterator &operator--() noexcept {
+            node_ = node_->last;
+            return *this;
+        }
+
+        basic_iterator operator--(int) noexcept {
+            basic_iterator before = *this;
+            node_ = node_->last;
+            return before;
+        }
+
+        friend bool operator==(const basic_iterator &a, const basic_iterator &b) noexcept {
+            return a.node_ == b.node_;
+        }
+
+        friend bool operator!=(const basic_iterator &a, const basic_iterator &b) noexcept {
+            return a.node_ != b.node_;
+        }
+
+    };
+
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /*
+
+        Constructors, Assignment, Destructor
+
+     */
+
+    fast_access_list() noexcept(noexcept(Alloc())): fast_access_list(Alloc()) {}
+
+    explicit fast_access_list(const Alloc &alloc) noexcept: alloc_(alloc) {
+        reset();
+    }
+
+    fast_access_list(std::initializer_list<T> values, const Alloc &alloc = Alloc()) : fast_access_list(alloc) {
+        for (const T &value : values)
+            emplace_back(value);
+    }
+
+    fast_access_list(const fast_access_list &other)
+            : fast_access_list(value_traits::select_on_container_copy_construction(other.alloc_)) {
+        for (const T &value : other)
+            emplace_back(value);
+    }
+
+    fast_access_list(fast_access_list &&other) noexcept: alloc_(std::move(other.alloc_)) {
+        reset();
+        attach(other.detach());
+    }
+
+    fast_access_list &operator=(const fast_access_list &other) {
+
+        if (this == &other)
+            return *this;
+
+        clear();
+
+        if constexpr (value_traits::propagate_on_container_copy_assignment::value)
+            alloc_ = other.alloc_;
+
+        for (const T &value : other)
+            emplace_back(value);
+
+        return *this;
+    }
+
+    fast_access_list &operator=(fast_access_list &&other) noexcept(
+    value_traits::propagate_on_container_move_assignment::value || value_traits::is_always_equal::value) {
+
+        if (this == &other)
+            return *this;
+
+        clear();
+
+        // Same memory, or the memory comes along: just take the nodes
+        if constexpr (value_traits::propagate_on_container_move_assignment::value) {
+            alloc_ = std::move(other.alloc_);
+            attach(other.detach());
+        } else if (alloc_ == other.alloc_)
+            attach(other.detach());
+
+            // Different memory: the elements have to move one by one
+        else {
+            for (T &value : other)
+                emplace_back(std::move(value));
+
+            other.clear();
+        }
+
+        return *this;
+    }
+
+    ~fast_access_list() {
+        clear();
+    }
+
+    allocator_type get_allocator() const noexcept { return alloc_; }
+
+    /*
+
+        Iterators
+
+     */
+
+    iterator begin() noexcept { return iterator(sentinel_.next); }
+
+    iterator end() noexcept { return iterator(&sentinel_); }
+
+    const_iterator begin() const noexcept { return const_iterator(sentinel_.next); }
+
+    const_iterator end() const noexcept { return const_iterator(const_cast<node_base *>(&sentinel_)); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    /*
+
+        Size
+
+     */
+
+    size_type size() const noexcept { return size_; }
+
+    bool empty() const noexcept { return size_ == 0; }
+
+    // Returns the Position of the Cursor
+    size_type cursor_position() const noexcept { return cursor_; }
+
+    /*
+
+        Access
+
+        operator[] and at() go through the cursor, just like getFromList:
+        O(1) to O(n) Time, and O(1) when walking through the indices in order.
+
+        The const ones start from the cursor too, but don't move it, so any number
+        of threads can read a list nobody is changing, like a std:: container.
+        On a const list, walking through the indices in order walks from the
+        cursor again every step, use the iterators for that.
+
+     */
+
+    reference operator[](size_type index) noexcept {
+        return *static_cast<node *>(locate(index))->value();
+    }
+
+    index_result operator[](size_type index) const noexcept {
+        return *static_cast<node *>(walk(index))->value();
+    }
+
+    reference at(size_type index) {
+        check_index(index, size_);
+        return (*this)[index];
+    }
+
+    index_result at(size_type index) const {
+        check_index(index, size_);
+        return (*this)[index];
+    }
+
+    reference front() noexcept { return *static_cast<node *>(sentinel_.next)->value(); }
+
+    const_reference front() const noexcept { return *static_cast<node *>(sentinel_.next)->value(); }
+
+    reference back() noexcept { return *static_cast<node *>(sentinel_.last)->value(); }
+
+    const_reference back() const noexcept { return *static_cast<node *>(sentinel_.last)->value(); }
+
+    /*
+
+        Adding
+
+     */
+
+    template<typename... Args>
+    reference emplace_back(Args &&... args) {
+        node *n = create(std::forward<Args>(args)...);
+        link_before(&sentinel_, n, size_);
+        return *n->value();
+    }
+
+    template<typename... Args>
+    reference emplace_front(Args &&... args) {
+        node *n = create(std::forward<Args>(args)...);
+        link_before(sentinel_.next, n, 0);
+        return *n->value();
+    }
+
+    // Constructs a new element before pos
+    template<typename... Args>
+    iterator emplace(const_iterator pos, Args &&... args) {
+        node *n = create(std::forward<Args>(args)...);
+        link_before(pos.node_, n, index_of(pos.node_));
+        return iterator(n);
+    }
+
+    // Constructs a new element at index (up to size()), like addToListAtIndex
+    template<typename... Args>
+    iterator emplace_at(size_type index, Args &&... args) {
+        check_index(index, size_ + 1);
+
+        node *n = create(std::forward<Args>(args)...);
+        link_before(index == size_ ? &sentinel_ : locate(index), n, index);
+        return iterator(n);
+    }
+
+    void push_back(const T &value) { emplace_back(value); }
+
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+
+    void push_front(const T &value) { emplace_front(value); }
+
+    void push_front(T &&value) { emplace_front(std::move(value)); }
+
+    iterator insert(const_iterator pos, const T &value) { return emplace(pos, value); }
+
+    iterator insert(const_iterator pos, T &&value) { return emplace(pos, std::move(value)); }
+
+    /*
+
+        Removing
+
+     */
+
+    // Removes the element at pos, returns the one after it
+    iterator erase(const_iterator pos) noexcept {
+        node_base *after = pos.node_->next;
+        destroy(unlink(pos.node_, index_of(pos.node_)));
+        return iterator(after);
+    }
+
+    // Removes the element at index, like removeFromListAtIndex
+    void erase_at(size_type index) {
+        check_index(index, size_);
+        destroy(unlink(locate(index), index));
+    }
+
+    void pop_front() noexcept { destroy(unlink(sentinel_.next, 0)); }
+
+    void pop_back() noexcept { destroy(unlink(sentinel_.last, size_ - 1)); }
+
+    // Removes all the elements
+    void clear() noexcept {
+
+        node_base *cur = sentinel_.next;
+
+        while (cur != &sentinel_) {
+            node_base *next = cur->next;
+            destroy(static_cast<node *>(cur));
+            cur = next;
+        }
+
+        reset();
+    }
+
+    void swap(fast_access_list &other) noexcept {
+
+        if constexpr (value_traits::propagate_on_container_swap::value) {
+            using std::swap;
+            swap(alloc_, other.alloc_);
+        }
+
+        chain mine = detach();
+        attach(other.detach());
+        other.attach(mine);
+    }
+
+    friend void swap(fast_access_list &a, fast_access_list &b) noexcept { a.swap(b); }
+
+    friend bool operator==(const fast_access_list &a, const fast_access_list &b) {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+    }
+
+    friend bool operator!=(const fast_access_list &a, const fast_access_list &b) {
+        return !(a == b);
+    }
+
+private:
+
+    /*
+
+        Chain
+
+        The nodes of a list, without the list, for moving them between lists.
+
+     */
+
+    struct chain {
+
+        node_base *first;
+        node_base *last;
+        size_type size;
+        size_type cursor;
+        node_base *node_at_cursor;
+
+    };
+
+    // Comes after the tail, and before the head
+    node_base sentinel_;
+
+    // Size
+    size_type size_;
+
+    // Recently accessed Node's Index
+    size_type cursor_;
+
+    // Recently accessed Node (the sentinel while the list is empty)
+    node_base *node_at_cursor_;
+
+    // Gives memory to the nodes and the elements
+    Alloc alloc_;
+
+    static void check_index(size_type index, size_type limit) {
+        if (index >= limit)
+            throw std::out_of_range("fast_access_list: index out of bounds");
+    }
+
+    // Makes the list empty, without touching any nodes
+    void reset() noexcept {
+        sentinel_.next = &sentinel_;
+        sentinel_.last = &sentinel_;
+        size_ = 0;
+        cursor_ = 0;
+        node_at_cursor_ = &sentinel_;
+    }
+
+    // Takes the nodes away, and leaves the list empty
+    chain detach() noexcept {
+        chain taken{sentinel_.next, sentinel_.last, size_, cursor_, node_at_cursor_};
+        reset();
+        return taken;
+    }
+
+    // Hooks the nodes in, the list must be empty
+    void attach(const chain &taken) noexcept {
+
+        if (taken.size == 0)
+            return;
+
+        sentinel_.next = taken.first;
+        sentinel_.last = taken.last;
+        taken.first->last = &sentinel_;
+        taken.last->next = &sentinel_;
+
+        size_ = taken.size;
+        cursor_ = taken.cursor;
+        node_at_cursor_ = taken.node_at_cursor;
+    }
+
+    // Allocates a node, and constructs its element
+    template<typename... Args>
+    node *create(Args &&... args) {
+
+        node_allocator nodes(alloc_);
+
+        node *n = node_traits::allocate(nodes, 1);
+
+        ::new(static_cast<void *>(n)) node;
+
+        try {
+            value_traits::construct(alloc_, n->value(), std::forward<Args>(args)...);
+        } catch (...) {
+            node_traits::deallocate(nodes, n, 1);
+            throw;
+        }
+
+        return n;
+    }
+
+    // Destroys the node's element, and frees the node
+    void destroy(node *n) noexcept {
+
+        node_allocator nodes(alloc_);
+
+        value_traits::destroy(alloc_, n->value());
+
+        n->~node();
+
+        node_traits::deallocate(nodes, n, 1);
+    }
+
+    // Index of a node, if we know it without walking
+    size_type index_of(const node_base *n) const noexcept {
+
+        if (n == sentinel_.next)
+            return 0;
+
+        if (n == &sentinel_)
+            return size_;
+
+        if (n == sentinel_.last)
+            return size_ - 1;
+
+        if (n == node_at_cursor_)
+            return cursor_;
+
+        return npos;
+    }
+
+    // Links n in before pos, which is at index (or npos)
+    void link_before(node_base *pos, node *n, size_type index) noexcept {
+
+        n->next = pos;
+        n->last = pos->last;
+        pos->last->next = n;
+        pos->last = n;
+
+        size_++;
+
+        // The first node, the cursor goes to it
+        if (size_ == 1) {
+            cursor_ = 0;
+            node_at_cursor_ = n;
+        }
+
+            // Don't know where it went, so we don't know if the cursor moved, start over from the head
+        else if (index == npos) {
+            cursor_ = 0;
+            node_at_cursor_ = sentinel_.next;
+        }
+
+            // If the cursor was after the new node, its node moved up by one
+        else if (cursor_ >= index)
+            cursor_++;
+    }
+
+    // Unlinks n, which is at index (or npos), and returns it
+    node *unlink(node_base *n, size_type index) noexcept {
+
+        n->last->next = n->next;
+        n->next->last = n->last;
+
+        size_--;
+
+        // The list is empty now
+        if (size_ == 0) {
+            cursor_ = 0;
+            node_at_cursor_ = &sentinel_;
+        }
+
+            // The cursor was on it, move it to the node taking its place (or the one before, if it was the tail)
+        else if (n == node_at_cursor_) {
+
+            if (n->next != &sentinel_)
+                node_at_cursor_ = n->next;
+            else {
+                node_at_cursor_ = n->last;
+                cursor_--;
+            }
+
+        }
+
+            // Don't know where it was, so we don't know if the cursor moved, start over from the head
+        else if (index == npos) {
+            cursor_ = 0;
+            node_at_cursor_ = sentinel_.next;
+        }
+
+            // If the cursor was after it, its node moved down by one
+        else if (cursor_ > index)
+            cursor_--;
+
+        return static_cast<node *>(n);
+    }
+
+    /*
+
+        node_base *walk(size_type index) const
+
+        Same as get in LinkedList.c: returns the node at index, starting from
+        whichever of head, tail, or cursor takes the least hops.
+        Only reads the cursor, so const access can run on many threads at once.
+
+     */
+
+    node_base *walk(size_type index) const noexcept {
+
+        if (index == 0)
+            return sentinel_.next;
+
+        if (index == size_ - 1)
+            return sentinel_.last;
+
+        if (index == cursor_)
+            return node_at_cursor_;
+
+        // Calculating The Distance
+        size_type from_head = index;
+        size_type from_tail = (size_ - 1) - index;
+        size_type from_cursor = cursor_ > index ? cursor_ - index : index - cursor_;
+
+        node_base *cur;
+
+        // Closest Path Is From Head
+        if (from_head <= from_cursor && from_head <= from_tail) {
+            cur = sentinel_.next;
+
+            for (size_type i = 0; i < from_head; ++i)
+                cur = cur->next;
+        }
+
+            // Closest Path Is From Tail
+        else if (from_tail < from_cursor) {
+            cur = sentinel_.last;
+
+            for (size_type i = 0; i < from_tail; ++i)
+                cur = cur->last;
+        }
+
+            // Closest Path Is From Cursor, forwards or backwards
+        else {
+            cur = node_at_cursor_;
+
+            if (index > cursor_)
+                for (size_type i = 0; i < from_cursor; ++i)
+                    cur = cur->next;
+            else
+                for (size_type i = 0; i < from_cursor; ++i)
+                    cur = cur->last;
+        }
+
+        return cur;
+    }
+
+    /*
+
+        node_base *locate(size_type index)
+
+        Same as walk, but leaves the cursor on the node, for the next access.
+
+     */
+
+    node_base *locate(size_type index) noexcept {
+
+        node_base *cur = walk(index);
+
+        cursor_ = index;
+        node_at_cursor_ = cur;
+
+        return cur;
+    }
+
+};
+
+/*
+
+    fast_access_pmr::fast_access_list<T>
+
+    A fast_access_list taking its memory from a std::pmr::memory_resource.
+
+ */
+
+namespace fast_access_pmr {
+
+    template<typename T>
+    using fast_access_list = ::fast_access_list<T, std::pmr::polymorphic_allocator<T>>;
+
+}
+
+
+#endif
@@ -59,8 +59,30 @@
 
  */
 
+#ifdef LINKEDLIST_TRACING
+// For clock_gettime
+#define _POSIX_C_SOURCE 200809L
+#include <time.h>
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+// The registry of live lists needs a lock, compile with -DLINKEDLIST_NO_REGISTRY
+// to leave it out, and with it the need for POSIX threads
+#ifndef LINKEDLIST_NO_REGISTRY
+#include <pthread.h>
+#endif
+
+#include "LinkedList.h"
+
+// SSE2 and AVX2 search kernels, picked at runtime (GCC and Clang on x86-64),
+// compile with -DLINKEDLIST_NO_SIMD to always use the scalar kernels
+#if defined(__GNUC__) && defined(__x86_64__) && !defined(LINKEDLIST_NO_SIMD)
+#define FIND_SIMD
+#include <immintrin.h>
+#endif
 
 // To know which path we have chosen [ 1: Head, 2: Tail, 0: Cursor]
 #define HEAD 1
@@ -98,6 +120,59 @@ typedef struct Node {
 
 } Node;
 
+/*
+
+    Checkpoint
+
+    A node of the list, and its index. Used by the Express Lane.
+
+ */
+
+typedef struct Checkpoint {
+
+    // Index of the node
+    int Index;
+
+    // The node
+    Node *Node;
+
+} Checkpoint;
+
+#ifdef LINKEDLIST_TRACING
+
+// One bucket per power of two nanoseconds
+#define LATENCY_BUCKETS 64
+
+/*
+
+    Latency Histogram
+
+    Bucket i counts the calls that took between 2^i and 2^(i + 1) - 1 nanoseconds.
+    A handful of counters per call, so it's cheap enough to leave on under real load.
+
+ */
+
+typedef struct LatencyHistogram {
+
+    // Number of calls
+    unsigned long long Count;
+
+    // Sum of all latencies, for the mean
+    unsigned long long TotalNanos;
+
+    // Fastest call
+    unsigned long long MinNanos;
+
+    // Slowest call
+    unsigned long long MaxNanos;
+
+    // Calls per bucket
+    unsigned long long Buckets[LATENCY_BUCKETS];
+
+} LatencyHistogram;
+
+#endif
+
 /*
 
     Linked List
@@ -129,658 +204,2854 @@ typedef struct LinkedList {
     // Recently accessed Node
     Node *NodeAtCursor;
 
-} LinkedList;
+    // Non - zero if the Express Lane is on
+    int ExpressLane;
 
+    // Every Stride-th node, in order of index
+    Checkpoint *Checkpoints;
 
-/*
+    // Number of checkpoints in use
+    int CheckpointCount;
 
-  LinkedList * newList()
+    // Number of checkpoints there is room for
+    int CheckpointCapacity;
 
-  This function initializes a new LinkedList in heap memory,
-  and returns the reference to it.
+    // Distance between checkpoints, about sqrt(Size)
+    int Stride;
 
-*/
+    // Changes to the list since the checkpoints were placed
+    int CheckpointChanges;
 
-LinkedList *newList() {
+    // Non - zero if the checkpoints must be placed again before they are used
+    int CheckpointsStale;
 
-    // Initialising in Heap and casting it to our data type
-    LinkedList *newList = (LinkedList *) malloc(sizeof(struct LinkedList));
+    // Values, when the list is stored as an array (NULL when stored as nodes)
+    void **Array;
 
-    // Setting default values
-    newList->Head = NULL;
-    newList->Tail = NULL;
-    newList->Size = 0;
-    newList->Cursor = 0;
-    newList->NodeAtCursor = NULL;
+    // Number of values there is room for in Array
+    int ArrayCapacity;
 
-    // Returning the reference to the list
-    return newList;
-}
+    // Non - zero if Adaptive Storage is on
+    int AdaptiveStorage;
 
-/*
+    // How much cheaper the other storage would have been lately
+    long long AdaptiveScore;
 
-    int getListCursorPosition(LinkedList *list)
-    - Returns the Position of the Cursor
+    // Next and Last list in the registry of live lists
+    struct LinkedList *NextLive;
+    struct LinkedList *LastLive;
 
- */
+#ifdef LINKEDLIST_TRACING
 
-int getListCursorPosition(LinkedList *list) {
-    return list->Cursor;
-}
+    // Called before every traced operation
+    ListTraceHook TraceBegin;
 
-/*
+    // Called after every traced operation
+    ListTraceHook TraceEnd;
 
-    int getListSize(LinkedList *list)
-    - Returns the size of the list
+    // Passed on to the hooks
+    void *TraceUserData;
 
- */
+    // One histogram per operation
+    LatencyHistogram Latency[LIST_OPERATION_COUNT];
+
+#endif
+
+} LinkedList;
 
-int getListSize(LinkedList *list) {
-    return list->Size;
-}
 
 /*
 
-    void *add(LinkedList *list, void *Value)
+    Tracing
 
-    This function initializes a new node in heap memory
-    and assigns the value of node to the provided value.
+    TRACE_BEGIN calls the Begin hook, and starts the clock, TRACE_END stops the clock,
+    puts the latency in the operation's histogram, and calls the End hook.
+    Without LINKEDLIST_TRACING, they are empty.
 
-*/
+ */
 
-void addToList(LinkedList *list, void *Value) {
+#ifdef LINKEDLIST_TRACING
 
-    // Initialising new node in heap and casting it to our data type.
-    Node *newNode = (Node *) malloc(sizeof(struct Node));
+#define TRACE_BEGIN(list, Operation) unsigned long long TraceStart = traceBegin(list, Operation)
+#define TRACE_END(list, Operation) traceEnd(list, Operation, TraceStart)
 
-    // Assigning values
-    newNode->Value = Value;
-    newNode->Next = NULL;
-    newNode->Last = NULL;
+/*
 
-    // Increment The Size
-    list->Size++;
+    static unsigned long long nowNanos()
 
-    // If it's the first element (Size==1 means first)
-    if (list->Size == 1) {
+    Returns the monotonic time in nanoseconds.
 
-        // Make head point to this node, because it's the first
-        list->Head = newNode;
+ */
 
-        // Make the tail point to this node,because it's also the last element
-        list->Tail = newNode;
+static unsigned long long nowNanos() {
 
-        // Make the NodeAtCursor point this node, because currently the cursor is at index 0.
-        list->NodeAtCursor = newNode;
+    struct timespec Now;
 
-    }
+    clock_gettime(CLOCK_MONOTONIC, &Now);
 
-        // If elements already exist in list (Size > 1)
-    else {
+    return (unsigned long long) Now.tv_sec * 1000000000ULL + (unsigned long long) Now.tv_nsec;
+}
 
-        // Get Tail Node (last node)
-        Node *lastNode = list->Tail;
+/*
 
-        // Set Tail Node's Next value to this node.
-        lastNode->Next = newNode;
+    static unsigned long long traceBegin(LinkedList *list, ListOperation Operation)
 
-        // Set newNode's Last value to Tail Node (interconnect each other)
-        newNode->Last = lastNode;
+    Calls the Begin hook, then returns the time the operation starts at.
 
-        // Now set Tail Node's address to this Node (because now this is the last node)
-        list->Tail = newNode;
+ */
 
-    }
+static unsigned long long traceBegin(LinkedList *list, ListOperation Operation) {
 
+    if (list->TraceBegin != NULL)
+        list->TraceBegin(list, Operation, list->TraceUserData);
+
+    return nowNanos();
 }
 
 /*
 
-    static Node* get(LinkedList *list, int Index)
-
-    This function returns the node located at a
-    given index.
+    static void traceEnd(LinkedList *list, ListOperation Operation, unsigned long long Start)
 
-    This function is abstracted. Hence, its static.
-    Use getFromList to access a value externally.
+    Records how long the operation took, then calls the End hook.
 
  */
 
+static void traceEnd(LinkedList *list, ListOperation Operation, unsigned long long Start) {
 
-static Node *get(LinkedList *list, int Index) {
+    unsigned long long Nanos = nowNanos() - Start;
 
-    // If Index is 0, the First Node, then return head node
-    if (Index <= 0) // // <= for binary search, sometimes values loose precision because of integer division
-        return list->Head;
+    LatencyHistogram *Histogram = &list->Latency[Operation];
 
-    // If Index is the last index, the Last Node (Size - 1), then return tail node
-    if (Index >= list->Size - 1) // >= for binary search, sometimes values loose precision because of integer division
-        return list->Tail;
+    // Bucket is the position of the highest set bit (| 1, because 0 has none)
+    int Bucket = 63 - __builtin_clzll(Nanos | 1);
 
-    // If Index is same as the cursor value, then return the NodeAtCursor
-    if (Index == list->Cursor)
-        return list->NodeAtCursor;
+    Histogram->Buckets[Bucket]++;
+    Histogram->Count++;
+    Histogram->TotalNanos += Nanos;
 
+    if (Nanos < Histogram->MinNanos)
+        Histogram->MinNanos = Nanos;
 
+    if (Nanos > Histogram->MaxNanos)
+        Histogram->MaxNanos = Nanos;
 
-    /*
+    if (list->TraceEnd != NULL)
+        list->TraceEnd(list, Operation, list->TraceUserData);
+}
 
-        Travelling through the list to find out value.
-        Because the index was not 0, or Size - 1, or Cursor.
+#else
 
-     */
+#define TRACE_BEGIN(list, Operation)
+#define TRACE_END(list, Operation)
 
+#endif
 
-    // To cache the node to start transversing from
-    Node **curNode = NULL;
+/*
 
-    int ChosenPath = CURSOR;
+    Registry
 
-    /*
+    Every list created with newList is kept in a linked list of its own
+    (yes, a linked list of linked lists), until deleteList removes it.
+    This lets us total the memory of all the lists in the process.
 
-        Calculating which is the best way to access the values.
-        In simple words, we are calculating which way will require
-        the least amount of hops to access our node:
-         - Will it take less hops if we start from NodeAtCursor?
-         - Will it take less hops if we start from Head Node?
-         - Will it take less hops if we start from Tail Node?
+    It costs every newList and deleteList a lock of one process wide mutex.
+    With LINKEDLIST_NO_REGISTRY, lists aren't registered, and the registry
+    stays empty.
 
-     */
+ */
 
-    // Calculating The Distance
-    int DistanceFromHead = Index;
-    int DistanceFromTail = (list->Size - 1) - Index;
-    int DistanceFromCursor = abs(list->Cursor - Index);
+// First live list
+static LinkedList *LiveLists = NULL;
 
+// Number of live lists
+static int LiveListCount = 0;
 
-    // If Closest Path Is From Head
-    // <= to handle stalemate situationsWhat if DistanceFromHead == DistanceFromTail?.
-    if (DistanceFromHead <= DistanceFromCursor && DistanceFromHead <= DistanceFromTail) {
-        curNode = &list->Head;
-        ChosenPath = HEAD;
-    }
-        // If Closest Path Is From Tail (We have checked If DistanceFromHead is Greater than DistanceFrom Tail,
-        // it's not right? It means it bigger from DistanceFromTail so we didn't check DistanceFromTail < DistanceFromCursor)
-    else if (DistanceFromTail < DistanceFromCursor) {
-        curNode = &list->Tail;
-        ChosenPath = TAIL;
-    }
-        //Well then, looks like the closest distance is from Cursor
-    else
-        curNode = &list->NodeAtCursor;
+#ifndef LINKEDLIST_NO_REGISTRY
 
-    /*
+// Guards the registry
+static pthread_mutex_t LiveListsLock = PTHREAD_MUTEX_INITIALIZER;
 
-      Travelling through list, by our chosen path
+#define LOCK_REGISTRY() pthread_mutex_lock(&LiveListsLock)
+#define UNLOCK_REGISTRY() pthread_mutex_unlock(&LiveListsLock)
 
-     */
+#else
 
-    switch (ChosenPath) {
+#define LOCK_REGISTRY()
+#define UNLOCK_REGISTRY()
 
-        /*
+#endif
 
-         Path: HEAD
+/*
 
-         If the chosen path is HEAD,
-         then move from start towards right, AKA Forward
+    static void registerList(LinkedList *list)
 
-        */
+    Adds the list to the start of the registry.
 
-        case HEAD: {
+ */
 
-            // Start Moving Forwards From Head, until we find the Node we want
-            for (int i = 0; i < DistanceFromHead; ++i) {
-                curNode = &(((Node *) (*curNode))->Next);
-            }
+static void registerList(LinkedList *list) {
 
-            // Update the Cursor Value ( Cursor Value == DistanceFromHead because, that's the node we are at now)
-            list->Cursor = DistanceFromHead;
+#ifndef LINKEDLIST_NO_REGISTRY
 
-            // Make the NodeAtCursor point towards this.
-            list->NodeAtCursor = *curNode;
+    LOCK_REGISTRY();
 
-            break;
-        }
+    list->LastLive = NULL;
+    list->NextLive = LiveLists;
 
-            /*
+    if (LiveLists != NULL)
+        LiveLists->LastLive = list;
 
-            Path: TAIL
+    LiveLists = list;
+    LiveListCount++;
 
-            If the chosen path is TAIL,
-            then move from end towards left, AKA Backward
+    UNLOCK_REGISTRY();
 
-            */
+#else
 
+    (void) list;
 
-        case TAIL: {
+#endif
+}
 
-            // Start Moving Backwards From TAIL, until we find the Node we want
-            for (int i = 0; i < DistanceFromTail; ++i) {
-                curNode = &(((Node *) (*curNode))->Last);
-            }
+/*
 
-            // Update the Cursor Value (We are subtracting list size from DistanceFromTail,
-            // because that's how many node's we are away from the list's end)
-            list->Cursor = (getListSize(list) - 1) - DistanceFromTail;
+    static void unregisterList(LinkedList *list)
 
-            // Make the NodeAtCursor point towards this.
-            list->NodeAtCursor = *curNode;
+    Removes the list from the registry.
 
+ */
 
-            break;
-        }
+static void unregisterList(LinkedList *list) {
 
-            /*
+#ifndef LINKEDLIST_NO_REGISTRY
 
-            Path: CURSOR
+    LOCK_REGISTRY();
 
-            If the chosen path is Cursor,
-            and if the Index is greater than the CURSOR,
-            then move from cursor towards right, AKA Forward
-            else if the Index is lesser than the CURSOR,
-            then move from cursor towards left, AKA Backward
+    if (list->LastLive != NULL)
+        list->LastLive->NextLive = list->NextLive;
+    else
+        LiveLists = list->NextLive;
 
-            */
+    if (list->NextLive != NULL)
+        list->NextLive->LastLive = list->LastLive;
 
+    LiveListCount--;
 
-        default: {
+    UNLOCK_REGISTRY();
 
-            // If the index is greater than the cursor, then move right
-            if (Index > list->Cursor) {
+#else
 
-                // Start Moving Forward
-                for (int i = 0; i < DistanceFromCursor; ++i) {
-                    curNode = &(((Node *) (*curNode))->Next);
-                }
+    (void) list;
 
-                // Update Cursor Value (adding because we moved forward)
-                list->Cursor += DistanceFromCursor;
+#endif
+}
 
-            }
+/*
 
-                // Else if the index is lesser than the cursor, then move left
-            else {
+  LinkedList * newList()
 
-                // Start Moving Backward
-                for (int i = 0; i < DistanceFromCursor; ++i) {
-                    curNode = &(((Node *) (*curNode))->Last);
-                }
+  This function initializes a new LinkedList in heap memory,
+  and returns the reference to it.
 
+*/
 
-                // Update Cursor Value (subtracting because we moved forward)
-                list->Cursor -= DistanceFromCursor;
-            }
+LinkedList *newList() {
 
-            // Update NodeAtCursor Value
-            list->NodeAtCursor = *curNode;
+    // Initialising in Heap and casting it to our data type
+    LinkedList *newList = (LinkedList *) malloc(sizeof(struct LinkedList));
 
-            break;
-        }
-    }
+    // Setting default values
+    newList->Head = NULL;
+    newList->Tail = NULL;
+    newList->Size = 0;
+    newList->Cursor = 0;
+    newList->NodeAtCursor = NULL;
 
+    newList->ExpressLane = 0;
+    newList->Checkpoints = NULL;
+    newList->CheckpointCount = 0;
+    newList->CheckpointCapacity = 0;
+    newList->Stride = 1;
+    newList->CheckpointChanges = 0;
+    newList->CheckpointsStale = 1;
 
-    curNode = &list->NodeAtCursor;
+    newList->Array = NULL;
+    newList->ArrayCapacity = 0;
+    newList->AdaptiveStorage = 0;
+    newList->AdaptiveScore = 0;
 
-    return (Node *) (*curNode);
-}
+#ifdef LINKEDLIST_TRACING
+    newList->TraceBegin = NULL;
+    newList->TraceEnd = NULL;
+    newList->TraceUserData = NULL;
+    resetListLatency(newList);
+#endif
+
+    registerList(newList);
 
+    // Returning the reference to the list
+    return newList;
+}
 
 /*
 
-    void* getFromList(LinkedList *list, int Index)
+    int getListCursorPosition(LinkedList *list)
+    - Returns the Position of the Cursor
+
+ */
+
+int getListCursorPosition(LinkedList *list) {
+    return list->Cursor;
+}
+
+/*
+
+    int getListSize(LinkedList *list)
+    - Returns the size of the list
+
+ */
+
+int getListSize(LinkedList *list) {
+    return list->Size;
+}
+
+/*
+
+    Express Lane
+
+    The cursor makes walking through the list in order cheap, but jumping to
+    random indices still costs O(n) hops. A full tree index is more than most
+    lists need, so instead, when the Express Lane is on, the list remembers
+    every Stride-th node (about every sqrt(n)-th) in a small array of checkpoints.
+
+    To get a node, get first jumps the cursor to the closest checkpoint (found
+    with a binary search), and walks from there, so it never takes more than
+    about sqrt(n) hops.
+
+    Keeping the checkpoints up to date is lazy:
+
+     -  Adding or removing a node only shifts the indices of the checkpoints
+        after it by one (at most sqrt(n) of them), the nodes stay where they are.
+     -  Every change can make the gap between two checkpoints grow, so once there
+        have been more than Stride changes, the checkpoints are marked stale,
+        and placed again from scratch (O(n)) the next time they are needed.
+     -  Appending doesn't move any checkpoint, it only makes the gap after the
+        last one grow, so addToList just adds a checkpoint on the tail when that
+        gap reaches Stride. The checkpoints are only placed again once the list
+        has grown enough for sqrt(n) to be twice the Stride, O(1) amortized.
+
+    That's O(sqrt(n)) hops per access, O(sqrt(n)) amortized per change,
+    and sqrt(n) checkpoints of memory.
+
+ */
+
+/*
+
+    static int squareRoot(int Number)
+
+    Returns the integer square root of Number (at least 1).
+
+ */
+
+static int squareRoot(int Number) {
+
+    int Root = 1;
+
+    while ((Root + 1) * (Root + 1) <= Number)
+        Root++;
+
+    return Root;
+}
+
+/*
+
+    static void placeCheckpoints(LinkedList *list)
+
+    Walks through the list, and places a checkpoint on every Stride-th node.
+
+ */
+
+static void placeCheckpoints(LinkedList *list) {
+
+    list->Stride = squareRoot(list->Size);
+
+    int Needed = (list->Size + list->Stride - 1) / list->Stride;
+
+    // Make room, with some to spare so the list can grow a bit before we have to allocate again
+    if (Needed > list->CheckpointCapacity) {
+        list->CheckpointCapacity = Needed + Needed / 2;
+        list->Checkpoints = (Checkpoint *) realloc(list->Checkpoints,
+                                                   sizeof(struct Checkpoint) * list->CheckpointCapacity);
+    }
+
+    Node *curNode = list->Head;
+
+    list->CheckpointCount = 0;
+
+    for (int i = 0; curNode != NULL; ++i) {
+
+        if (i % list->Stride == 0) {
+            list->Checkpoints[list->CheckpointCount].Index = i;
+            list->Checkpoints[list->CheckpointCount].Node = curNode;
+            list->CheckpointCount++;
+        }
+
+        curNode = curNode->Next;
+    }
+
+    list->CheckpointChanges = 0;
+    list->CheckpointsStale = 0;
+}
+
+/*
+
+    static void noteCheckpointChange(LinkedList *list)
+
+    Counts a change to the list, and marks the checkpoints
+    stale once there have been too many.
+
+ */
+
+static void noteCheckpointChange(LinkedList *list) {
+
+    if (!list->ExpressLane)
+        return;
+
+    list->CheckpointChanges++;
+
+    if (list->CheckpointChanges > list->Stride)
+        list->CheckpointsStale = 1;
+}
+
+/*
+
+    static void checkpointAppend(LinkedList *list)
+
+    A node was added at the end. Puts a checkpoint on it if it's Stride
+    nodes past the last one, no other checkpoint moves.
+
+ */
+
+static void checkpointAppend(LinkedList *list) {
+
+    // If they are stale, they will be placed from scratch anyway
+    if (!list->ExpressLane || list->CheckpointsStale)
+        return;
+
+    // The list has grown so much, the Stride is too short, place them again
+    if ((long long) list->Size >= 4LL * list->Stride * list->Stride) {
+        list->CheckpointsStale = 1;
+        return;
+    }
+
+    int TailIndex = list->Size - 1;
+
+    if (list->CheckpointCount > 0 &&
+        TailIndex - list->Checkpoints[list->CheckpointCount - 1].Index < list->Stride)
+        return;
+
+    // Make room, with some to spare, just like placeCheckpoints
+    if (list->CheckpointCount == list->CheckpointCapacity) {
+        list->CheckpointCapacity = list->CheckpointCapacity + list->CheckpointCapacity / 2 + 1;
+        list->Checkpoints = (Checkpoint *) realloc(list->Checkpoints,
+                                                   sizeof(struct Checkpoint) * list->CheckpointCapacity);
+    }
+
+    list->Checkpoints[list->CheckpointCount].Index = TailIndex;
+    list->Checkpoints[list->CheckpointCount].Node = list->Tail;
+    list->CheckpointCount++;
+}
+
+/*
+
+    static void shiftCheckpointsAfterInsert(LinkedList *list, int Index)
+
+    A node was added at Index, so every checkpoint at Index
+    or after it is now one further down the list.
+
+ */
+
+static void shiftCheckpointsAfterInsert(LinkedList *list, int Index) {
+
+    if (!list->ExpressLane)
+        return;
+
+    // Checkpoints are in order of index, so start from the end
+    for (int i = list->CheckpointCount - 1; i >= 0 && list->Checkpoints[i].Index >= Index; --i)
+        list->Checkpoints[i].Index++;
+
+    noteCheckpointChange(list);
+}
+
+/*
+
+    static void shiftCheckpointsAfterRemove(LinkedList *list, int Index)
+
+    The node at Index was removed, so every checkpoint after it is now
+    one further up the list, and the checkpoint on it (if any) goes.
+
+ */
+
+static void shiftCheckpointsAfterRemove(LinkedList *list, int Index) {
+
+    if (!list->ExpressLane)
+        return;
+
+    // Checkpoints are in order of index, so start from the end
+    int i = list->CheckpointCount - 1;
+
+    for (; i >= 0 && list->Checkpoints[i].Index > Index; --i)
+        list->Checkpoints[i].Index--;
+
+    // Drop the checkpoint on the removed node
+    if (i >= 0 && list->Checkpoints[i].Index == Index) {
+
+        for (int j = i; j < list->CheckpointCount - 1; ++j)
+            list->Checkpoints[j] = list->Checkpoints[j + 1];
+
+        list->CheckpointCount--;
+    }
+
+    noteCheckpointChange(list);
+}
+
+/*
+
+    static void jumpToCheckpoint(LinkedList *list, int Index)
+
+    Finds the checkpoint closest to Index, and if it's closer than
+    the head, the tail, and the cursor, moves the cursor onto it.
+
+ */
+
+static void jumpToCheckpoint(LinkedList *list, int Index) {
+
+    if (list->CheckpointsStale)
+        placeCheckpoints(list);
+
+    if (list->CheckpointCount == 0)
+        return;
+
+    // Binary Search for the last checkpoint at or before Index
+    int Start = 0;
+    int End = list->CheckpointCount - 1;
+    int Before = -1;
+
+    while (Start <= End) {
+
+        int Middle = Start + (End - Start) / 2;
+
+        if (list->Checkpoints[Middle].Index <= Index) {
+            Before = Middle;
+            Start = Middle + 1;
+        } else
+            End = Middle - 1;
+
+    }
+
+    // The closest one is either that one, or the one after it
+    int Closest = Before;
+
+    if (Closest < 0 || (Before + 1 < list->CheckpointCount &&
+                        list->Checkpoints[Before + 1].Index - Index < Index - list->Checkpoints[Before].Index))
+        Closest = Before + 1;
+
+    Checkpoint *Chosen = &list->Checkpoints[Closest];
+
+    // Closest distance without the checkpoints
+    int Distance = Index;
+
+    if ((list->Size - 1) - Index < Distance)
+        Distance = (list->Size - 1) - Index;
+
+    if (abs(list->Cursor - Index) < Distance)
+        Distance = abs(list->Cursor - Index);
+
+    // Only jump if it saves hops
+    if (abs(Chosen->Index - Index) < Distance) {
+        list->Cursor = Chosen->Index;
+        list->NodeAtCursor = Chosen->Node;
+    }
+}
+
+/*
+
+    void enableListExpressLane(LinkedList *list)
+
+    Turns on the Express Lane. The checkpoints are placed the first time they are needed.
+
+ */
+
+void enableListExpressLane(LinkedList *list) {
+
+    list->ExpressLane = 1;
+    list->CheckpointsStale = 1;
+}
+
+/*
+
+    void disableListExpressLane(LinkedList *list)
+
+    Turns off the Express Lane, and frees the checkpoints.
+
+ */
+
+void disableListExpressLane(LinkedList *list) {
+
+    list->ExpressLane = 0;
+
+    free(list->Checkpoints);
+
+    list->Checkpoints = NULL;
+    list->CheckpointCount = 0;
+    list->CheckpointCapacity = 0;
+    list->CheckpointsStale = 1;
+}
+
+/*
+
+    Adaptive Storage
+
+    Some lists are read by index all day long and hardly ever changed in the
+    middle, for those a plain array of values is better: O(1) getFromList, and
+    forEachElementInList and findValueInList run over contiguous memory.
+    Others are edited in place all the time, near the cursor or the head,
+    and for those the nodes are better: no shifting half the array around.
+
+    With Adaptive Storage on, the list watches what it's used for, and moves
+    its values between an array and nodes on its own, behind the same functions.
+
+    It keeps a score of how much cheaper the other storage would have been:
+
+     -  getFromList: the nodes cost a hop per node walked (from the closest of
+        head, tail, cursor, or checkpoint), the array costs nothing.
+     -  addToListAtIndex and removeFromListAtIndex: the nodes cost the same hops
+        to find the index, the array costs moving every value after it.
+     -  addToListAtIndex and removeFromListAtIndex on nodes also cost
+        ADAPTIVE_NODE_COST, for allocating or freeing the node.
+
+    Once the score is bigger than what moving all the values costs, the list moves
+    to the other storage, and the score starts from zero again. The score can't drop
+    below minus that cost either, so old history is forgotten. Together, that's the
+    hysteresis: a couple of odd operations never make the list switch back and forth,
+    and switching only happens when it has already paid for itself.
+
+    Every cost is counted in values moved by memmove, the cheapest thing here.
+    The defaults were measured with bench/AdaptiveStorageBench.c (x86-64, glibc,
+    1000 to 100000 values): memmove moves a value in 0.07 to 0.2 ns, a hop takes
+    2.5 to 3.5 ns, adding or removing a node 10 to 20 ns (malloc and free), and
+    moving a value between array and nodes 8 to 13 ns, about 30, 130 and 130 values.
+
+ */
+
+// Cost of walking one node, compared to moving one value in the array
+#ifndef ADAPTIVE_HOP_COST
+#define ADAPTIVE_HOP_COST 32
+#endif
+
+// Cost of allocating or freeing the node, for every add or remove on nodes
+#ifndef ADAPTIVE_NODE_COST
+#define ADAPTIVE_NODE_COST 128
+#endif
+
+// Cost of moving one value between array and nodes
+#ifndef ADAPTIVE_MIGRATION_COST
+#define ADAPTIVE_MIGRATION_COST 128
+#endif
+
+// Cost added to every move, so tiny lists don't switch all the time
+#ifndef ADAPTIVE_MIGRATION_BASE
+#define ADAPTIVE_MIGRATION_BASE 1024
+#endif
+
+/*
+
+    static void reserveArray(LinkedList *list, int Needed)
+
+    Makes sure the array has room for Needed values, doubling it if not.
+
+ */
+
+static void reserveArray(LinkedList *list, int Needed) {
+
+    if (Needed <= list->ArrayCapacity)
+        return;
+
+    int Capacity = list->ArrayCapacity * 2;
+
+    if (Capacity < Needed)
+        Capacity = Needed;
+
+    list->Array = (void **) realloc(list->Array, sizeof(void *) * Capacity);
+    list->ArrayCapacity = Capacity;
+}
+
+/*
+
+    static void migrateToArray(LinkedList *list)
+
+    Copies the values into a new array, and frees the nodes (not the values).
+    The cursor keeps its index.
+
+ */
+
+static void migrateToArray(LinkedList *list) {
+
+    int Capacity = list->Size + list->Size / 2 + 8;
+
+    void **Array = (void **) malloc(sizeof(void *) * Capacity);
+
+    // Get first node
+    Node *curNode = list->Head;
+
+    // To store reference to next node
+    Node *NextNode;
+
+    for (int i = 0; curNode != NULL; ++i) {
+        NextNode = curNode->Next;
+
+        Array[i] = curNode->Value;
+
+        // GC Node, the value lives on in the array
+        free(curNode);
+
+        curNode = NextNode;
+    }
+
+    list->Array = Array;
+    list->ArrayCapacity = Capacity;
+
+    list->Head = NULL;
+    list->Tail = NULL;
+    list->NodeAtCursor = NULL;
+
+    // Every checkpoint pointed to a node that's gone
+    list->CheckpointCount = 0;
+    list->CheckpointsStale = 1;
+}
+
+/*
+
+    static void migrateToNodes(LinkedList *list)
+
+    Puts the values back into nodes, and frees the array.
+    The cursor goes back to the head.
+
+ */
+
+static void migrateToNodes(LinkedList *list) {
+
+    void **Array = list->Array;
+    int Size = list->Size;
+
+    list->Array = NULL;
+    list->ArrayCapacity = 0;
+
+    list->Size = 0;
+    list->Cursor = 0;
+
+    for (int i = 0; i < Size; ++i) {
+
+        Node *newNode = (Node *) malloc(sizeof(struct Node));
+
+        newNode->Value = Array[i];
+        newNode->Next = NULL;
+        newNode->Last = list->Tail;
+
+        if (list->Tail == NULL) {
+            list->Head = newNode;
+            list->NodeAtCursor = newNode;
+        } else
+            list->Tail->Next = newNode;
+
+        list->Tail = newNode;
+        list->Size++;
+    }
+
+    free(Array);
+}
+
+/*
+
+    static void useNodeStorage(LinkedList *list)
+
+    Functions that work on the nodes themselves call this first,
+    to move the values back into nodes if they are in an array.
+
+ */
+
+static void useNodeStorage(LinkedList *list) {
+
+    if (list->Array != NULL) {
+        migrateToNodes(list);
+        list->AdaptiveScore = 0;
+    }
+}
+
+/*
+
+    static int hopsTo(LinkedList *list, int Index)
+
+    Estimates how many nodes get would walk to reach Index.
+
+ */
+
+static int hopsTo(LinkedList *list, int Index) {
+
+    if (Index <= 0 || Index >= list->Size - 1)
+        return 0;
+
+    int Hops = Index;
+
+    if ((list->Size - 1) - Index < Hops)
+        Hops = (list->Size - 1) - Index;
+
+    if (abs(list->Cursor - Index) < Hops)
+        Hops = abs(list->Cursor - Index);
+
+    // The express lane never walks more than a stride
+    if (list->ExpressLane && list->Stride < Hops)
+        Hops = list->Stride;
+
+    return Hops;
+}
+
+/*
+
+    static void weighStorage(LinkedList *list, long long NodeCost, long long ArrayCost)
+
+    Adds what the current storage cost more than the other one to the score,
+    and moves to the other storage once the score has paid for the move.
+
+ */
+
+static void weighStorage(LinkedList *list, long long NodeCost, long long ArrayCost) {
+
+    if (!list->AdaptiveStorage)
+        return;
+
+    long long MigrationCost = (long long) list->Size * ADAPTIVE_MIGRATION_COST + ADAPTIVE_MIGRATION_BASE;
+
+    if (list->Array != NULL)
+        list->AdaptiveScore += ArrayCost - NodeCost;
+    else
+        list->AdaptiveScore += NodeCost - ArrayCost;
+
+    // Forget old history
+    if (list->AdaptiveScore < -MigrationCost)
+        list->AdaptiveScore = -MigrationCost;
+
+    if (list->AdaptiveScore <= MigrationCost)
+        return;
+
+    if (list->Array != NULL)
+        migrateToNodes(list);
+    else
+        migrateToArray(list);
+
+    list->AdaptiveScore = 0;
+}
+
+/*
+
+    static void weighGet(LinkedList *list, int Index)
+
+    Weighs getting Index.
+
+ */
+
+static void weighGet(LinkedList *list, int Index) {
+
+    if (list->AdaptiveStorage)
+        weighStorage(list, (long long) hopsTo(list, Index) * ADAPTIVE_HOP_COST, 0);
+}
+
+/*
+
+    static void weighChange(LinkedList *list, int Index, int Moved)
+
+    Weighs adding or removing at Index, which moves Moved values in the array.
+
+ */
+
+static void weighChange(LinkedList *list, int Index, int Moved) {
+
+    if (list->AdaptiveStorage)
+        weighStorage(list, (long long) hopsTo(list, Index) * ADAPTIVE_HOP_COST + ADAPTIVE_NODE_COST, Moved);
+}
+
+/*
+
+    static void insertIntoArray(LinkedList *list, void *Value, int Index)
+
+    addToListAtIndex for array storage, moves everything from Index on up by one.
+
+ */
+
+static void insertIntoArray(LinkedList *list, void *Value, int Index) {
+
+    reserveArray(list, list->Size + 1);
+
+    memmove(list->Array + Index + 1, list->Array + Index, sizeof(void *) * (list->Size - Index));
+
+    list->Array[Index] = Value;
+    list->Size++;
+
+    // The cursor follows its value, just like with nodes
+    if (list->Cursor > Index)
+        list->Cursor++;
+}
+
+/*
+
+    static void removeFromArray(LinkedList *list, int Index)
+
+    removeFromListAtIndex for array storage, moves everything after Index down by one.
+
+ */
+
+static void removeFromArray(LinkedList *list, int Index) {
+
+    memmove(list->Array + Index, list->Array + Index + 1, sizeof(void *) * (list->Size - Index - 1));
+
+    list->Size--;
+
+    // The cursor follows its value, and stays inside the list
+    if (list->Cursor > Index || list->Cursor >= list->Size)
+        list->Cursor = list->Cursor > 0 ? list->Cursor - 1 : 0;
+}
+
+/*
+
+    void enableListAdaptiveStorage(LinkedList *list)
+
+    Turns on Adaptive Storage. The list starts in the storage it's in.
+
+ */
+
+void enableListAdaptiveStorage(LinkedList *list) {
+
+    list->AdaptiveStorage = 1;
+    list->AdaptiveScore = 0;
+}
+
+/*
+
+    void disableListAdaptiveStorage(LinkedList *list)
+
+    Turns off Adaptive Storage, and moves the values back into nodes.
+
+ */
+
+void disableListAdaptiveStorage(LinkedList *list) {
+
+    list->AdaptiveStorage = 0;
+
+    useNodeStorage(list);
+}
+
+/*
+
+    int isListStoredAsArray(LinkedList *list)
+
+    Returns non - zero if the values are in an array right now.
+
+ */
+
+int isListStoredAsArray(LinkedList *list) {
+    return list->Array != NULL;
+}
+
+/*
+
+    void *add(LinkedList *list, void *Value)
+
+    This function initializes a new node in heap memory
+    and assigns the value of node to the provided value.
+
+*/
+
+void addToList(LinkedList *list, void *Value) {
+
+    TRACE_BEGIN(list, LIST_ADD);
+
+    // Array storage, just put it at the end
+    if (list->Array != NULL) {
+        reserveArray(list, list->Size + 1);
+        list->Array[list->Size++] = Value;
+
+        TRACE_END(list, LIST_ADD);
+        return;
+    }
+
+    // Initialising new node in heap and casting it to our data type.
+    Node *newNode = (Node *) malloc(sizeof(struct Node));
+
+    // Assigning values
+    newNode->Value = Value;
+    newNode->Next = NULL;
+    newNode->Last = NULL;
+
+    // Increment The Size
+    list->Size++;
+
+    // If it's the first element (Size==1 means first)
+    if (list->Size == 1) {
+
+        // Make head point to this node, because it's the first
+        list->Head = newNode;
+
+        // Make the tail point to this node,because it's also the last element
+        list->Tail = newNode;
+
+        // Make the NodeAtCursor point this node, because currently the cursor is at index 0.
+        list->NodeAtCursor = newNode;
+
+    }
+
+        // If elements already exist in list (Size > 1)
+    else {
+
+        // Get Tail Node (last node)
+        Node *lastNode = list->Tail;
+
+        // Set Tail Node's Next value to this node.
+        lastNode->Next = newNode;
+
+        // Set newNode's Last value to Tail Node (interconnect each other)
+        newNode->Last = lastNode;
+
+        // Now set Tail Node's address to this Node (because now this is the last node)
+        list->Tail = newNode;
+
+    }
+
+    // No checkpoint moves, but the gap after the last one grows
+    checkpointAppend(list);
+
+    TRACE_END(list, LIST_ADD);
+}
+
+/*
+
+    static Node* get(LinkedList *list, int Index)
+
+    This function returns the node located at a
+    given index.
+
+    This function is abstracted. Hence, its static.
+    Use getFromList to access a value externally.
+
+ */
+
+
+static Node *get(LinkedList *list, int Index) {
+
+    // If Index is 0, the First Node, then return head node
+    if (Index <= 0) // // <= for binary search, sometimes values loose precision because of integer division
+        return list->Head;
+
+    // If Index is the last index, the Last Node (Size - 1), then return tail node
+    if (Index >= list->Size - 1) // >= for binary search, sometimes values loose precision because of integer division
+        return list->Tail;
+
+    // If Index is same as the cursor value, then return the NodeAtCursor
+    if (Index == list->Cursor)
+        return list->NodeAtCursor;
+
+
+
+    /*
+
+        Travelling through the list to find out value.
+        Because the index was not 0, or Size - 1, or Cursor.
+
+     */
+
+
+    // To cache the node to start transversing from
+    Node **curNode = NULL;
+
+    int ChosenPath = CURSOR;
+
+    /*
+
+        Calculating which is the best way to access the values.
+        In simple words, we are calculating which way will require
+        the least amount of hops to access our node:
+         - Will it take less hops if we start from NodeAtCursor?
+         - Will it take less hops if we start from Head Node?
+         - Will it take less hops if we start from Tail Node?
+
+     */
+
+    // If a checkpoint is closer than the cursor, move the cursor there first
+    if (list->ExpressLane)
+        jumpToCheckpoint(list, Index);
+
+    // Calculating The Distance
+    int DistanceFromHead = Index;
+    int DistanceFromTail = (list->Size - 1) - Index;
+    int DistanceFromCursor = abs(list->Cursor - Index);
+
+
+    // If Closest Path Is From Head
+    // <= to handle stalemate situationsWhat if DistanceFromHead == DistanceFromTail?.
+    if (DistanceFromHead <= DistanceFromCursor && DistanceFromHead <= DistanceFromTail) {
+        curNode = &list->Head;
+        ChosenPath = HEAD;
+    }
+        // If Closest Path Is From Tail (We have checked If DistanceFromHead is Greater than DistanceFrom Tail,
+        // it's not right? It means it bigger from DistanceFromTail so we didn't check DistanceFromTail < DistanceFromCursor)
+    else if (DistanceFromTail < DistanceFromCursor) {
+        curNode = &list->Tail;
+        ChosenPath = TAIL;
+    }
+        //Well then, looks like the closest distance is from Cursor
+    else
+        curNode = &list->NodeAtCursor;
+
+    /*
+
+      Travelling through list, by our chosen path
+
+     */
+
+    switch (ChosenPath) {
+
+        /*
+
+         Path: HEAD
+
+         If the chosen path is HEAD,
+         then move from start towards right, AKA Forward
+
+        */
+
+        case HEAD: {
+
+            // Start Moving Forwards From Head, until we find the Node we want
+            for (int i = 0; i < DistanceFromHead; ++i) {
+                curNode = &(((Node *) (*curNode))->Next);
+            }
+
+            // Update the Cursor Value ( Cursor Value == DistanceFromHead because, that's the node we are at now)
+            list->Cursor = DistanceFromHead;
+
+            // Make the NodeAtCursor point towards this.
+            list->NodeAtCursor = *curNode;
+
+            break;
+        }
+
+            /*
+
+            Path: TAIL
+
+            If the chosen path is TAIL,
+            then move from end towards left, AKA Backward
+
+            */
+
+
+        case TAIL: {
+
+            // Start Moving Backwards From TAIL, until we find the Node we want
+            for (int i = 0; i < DistanceFromTail; ++i) {
+                curNode = &(((Node *) (*curNode))->Last);
+            }
+
+            // Update the Cursor Value (We are subtracting list size from DistanceFromTail,
+            // because that's how many node's we are away from the list's end)
+            list->Cursor = (getListSize(list) - 1) - DistanceFromTail;
+
+            // Make the NodeAtCursor point towards this.
+            list->NodeAtCursor = *curNode;
+
+
+            break;
+        }
+
+            /*
+
+            Path: CURSOR
+
+            If the chosen path is Cursor,
+            and if the Index is greater than the CURSOR,
+            then move from cursor towards right, AKA Forward
+            else if the Index is lesser than the CURSOR,
+            then move from cursor towards left, AKA Backward
+
+            */
+
+
+        default: {
+
+            // If the index is greater than the cursor, then move right
+            if (Index > list->Cursor) {
+
+                // Start Moving Forward
+                for (int i = 0; i < DistanceFromCursor; ++i) {
+                    curNode = &(((Node *) (*curNode))->Next);
+                }
+
+                // Update Cursor Value (adding because we moved forward)
+                list->Cursor += DistanceFromCursor;
+
+            }
+
+                // Else if the index is lesser than the cursor, then move left
+            else {
+
+                // Start Moving Backward
+                for (int i = 0; i < DistanceFromCursor; ++i) {
+                    curNode = &(((Node *) (*curNode))->Last);
+                }
+
+
+                // Update Cursor Value (subtracting because we moved forward)
+                list->Cursor -= DistanceFromCursor;
+            }
+
+            // Update NodeAtCursor Value
+            list->NodeAtCursor = *curNode;
+
+            break;
+        }
+    }
+
+
+    curNode = &list->NodeAtCursor;
+
+    return (Node *) (*curNode);
+}
+
+
+/*
+
+    static void *getValue(LinkedList *list, int Index)
+
+    Returns the value at the index, from the array, or from the node
+    get finds. Just like get, indices outside the list give the first or last value.
+
+ */
+
+static void *getValue(LinkedList *list, int Index) {
+
+    if (list->Array == NULL)
+        return get(list, Index)->Value;
+
+    if (Index < 0)
+        Index = 0;
+
+    if (Index > list->Size - 1)
+        Index = list->Size - 1;
+
+    list->Cursor = Index;
+
+    return list->Array[Index];
+}
+
+/*
+
+    void* getFromList(LinkedList *list, int Index)
+
+    This function returns a value from stored
+    in the node found at the index
+
+ */
+
+void *getFromList(LinkedList *list, int Index) {
+
+    TRACE_BEGIN(list, LIST_GET);
+
+    weighGet(list, Index);
+
+    void *Value = getValue(list, Index);
+
+    TRACE_END(list, LIST_GET);
+
+    return Value;
+}
+
+/*
+
+    Batched Access
+
+    Fetching many arbitrary indices one getFromList at a time makes the cursor
+    bounce around the list, which can cost close to O(n) per index. If we visit
+    the indices in ascending order instead, the cursor only ever moves forwards,
+    and the whole batch costs a single sweep through the list.
+
+ */
+
+/*
+
+    Requested Index
+
+    An index together with its position in the caller's array,
+    so the value can be written back in the caller's order.
+
+ */
+
+typedef struct RequestedIndex {
+
+    // Index in the list
+    int Index;
+
+    // Position in the caller's array
+    int Position;
+
+} RequestedIndex;
+
+/*
+
+    static int compareRequestedIndices(const void *A, const void *B)
+
+    Sorts requested indices in ascending order, for qsort.
+
+ */
+
+static int compareRequestedIndices(const void *A, const void *B) {
+
+    int IndexA = ((const RequestedIndex *) A)->Index;
+    int IndexB = ((const RequestedIndex *) B)->Index;
+
+    return (IndexA > IndexB) - (IndexA < IndexB);
+}
+
+/*
+
+    void getManyFromList(LinkedList *list, const int *Indices, int Count, void **Destination)
+
+    Gets the values at all the indices, visiting them in ascending order.
+
+ */
+
+void getManyFromList(LinkedList *list, const int *Indices, int Count, void **Destination) {
+
+    // Check all indices first, and see if they are already sorted
+    int Sorted = 1;
+
+    for (int i = 0; i < Count; ++i) {
+
+        if (Indices[i] < 0 || Indices[i] >= list->Size) {
+            printf("INDEX OUT OF BOUNDS EXCEPTION. ATTEMPT TO INDEX INVALID INDEX %i\n", Indices[i]);
+            exit(-1);
+        }
+
+        if (i > 0 && Indices[i] < Indices[i - 1])
+            Sorted = 0;
+    }
+
+    // Already sorted, just sweep through them
+    if (Sorted) {
+
+        for (int i = 0; i < Count; ++i) {
+            weighGet(list, Indices[i]);
+            Destination[i] = getValue(list, Indices[i]);
+        }
+
+        return;
+    }
+
+    // Else sort them, remembering where each one came from
+    RequestedIndex *Requested = (RequestedIndex *) malloc(sizeof(struct RequestedIndex) * Count);
+
+    for (int i = 0; i < Count; ++i) {
+        Requested[i].Index = Indices[i];
+        Requested[i].Position = i;
+    }
+
+    qsort(Requested, Count, sizeof(struct RequestedIndex), compareRequestedIndices);
+
+    // Sweep through them, and write each value back to where the caller asked for it
+    for (int i = 0; i < Count; ++i) {
+        weighGet(list, Requested[i].Index);
+        Destination[Requested[i].Position] = getValue(list, Requested[i].Index);
+    }
+
+    free(Requested);
+}
+
+/*
+
+    void addToListAtIndex(LinkedList *list, void *Value, int Index)
+
+    Adds a new element to the list at a given index, before the value that was there,
+    so it lands at Index, Size - 1 included. Appending is addToList's job.
+
+ */
+
+void addToListAtIndex(LinkedList *list, void *Value, int Index) {
+
+    TRACE_BEGIN(list, LIST_ADD_AT_INDEX);
+
+    if (Index < 0 || Index >= list->Size) {
+        printf("INDEX OUT OF BOUNDS EXCEPTION. ATTEMPT TO INDEX INVALID INDEX %i\n", Index);
+        exit(-1);
+    }
+
+    weighChange(list, Index, list->Size - Index);
+
+    // Array storage, move everything from Index on up by one
+    if (list->Array != NULL) {
+        insertIntoArray(list, Value, Index);
+
+        TRACE_END(list, LIST_ADD_AT_INDEX);
+        return;
+    }
+
+    Node *newNode = (Node *) malloc(sizeof(struct Node));
+    newNode->Value = Value;
+    newNode->Next = NULL;
+    newNode->Last = NULL;
+
+    Node *CurNode = NULL;
+    Node *NodeBefore = NULL;
+
+
+    // If Index is 0, adding the node at the start of the list.
+    if (Index == 0) {
+
+        // Cache head node's reference to CurNode
+        CurNode = list->Head;
+
+        // Set Head Node's Last Node Value to new node
+        CurNode->Last = newNode;
+
+        // Set new node's next value to head node ( connecting each other )
+        newNode->Next = CurNode;
+
+        // Now set list's head to new node, because that's our new head node now right?
+        list->Head = newNode;
+
+    }
+
+        //Well, if the index is somewhere after the head (the tail included, the new node goes
+        // before it, so it ends up at Index), we need to find the particular node at index now.
+    else {
+
+        // Cache reference to the node once we find it.
+        CurNode = get(list, Index);
+
+        // Cache reference to the node before it, it's right there.
+        NodeBefore = CurNode->Last;
+
+        // NB NN <- CN
+        // (NB: NodeBefore, NN: NewNode, CN: CurNode, Connections: - or =, Direction: < or > )
+
+        // Now set CurNode's last value to our new node.
+        CurNode->Last = newNode;
+
+        // NB NN <=> CN
+
+        // Now set newNode's next to CurNode
+        newNode->Next = CurNode;
+
+        // NB -> NN <=> CN
+
+        // Now set NodeBefore's next to cur node
+        NodeBefore->Next = newNode;
+
+        // NB <=> NN <=> CN
+
+        // Now set newNode's last to NodeBefore
+        newNode->Last = NodeBefore;
+
+    }
+
+    // Making sure our NodeAtCursor is not corrupted while adding nodes,
+    // if the cursor was after the new node, its node moved up by one.
+    if (list->Cursor == Index)
+        list->NodeAtCursor = newNode;
+    else if (list->Cursor > Index)
+        list->Cursor++;
+
+    // Checkpoints after the new node moved up by one as well
+    shiftCheckpointsAfterInsert(list, Index);
+
+    //Incrementing List Size
+    list->Size++;
+
+    TRACE_END(list, LIST_ADD_AT_INDEX);
+}
+
+/*
+
+    void removeFromListAtIndex(LinkedList *list, int Index);
+
+    To Remove a value from the list
+
+*/
+
+void removeFromListAtIndex(LinkedList *list, int Index) {
+
+    TRACE_BEGIN(list, LIST_REMOVE_AT_INDEX);
+
+    if (Index < 0 || Index >= list->Size) {
+        printf("INDEX OUT OF BOUNDS EXCEPTION. ATTEMPT TO INDEX INVALID INDEX %i\n", Index);
+        exit(-1);
+    }
+
+    weighChange(list, Index, list->Size - Index - 1);
+
+    // Array storage, move everything after Index down by one
+    if (list->Array != NULL) {
+        removeFromArray(list, Index);
+
+        TRACE_END(list, LIST_REMOVE_AT_INDEX);
+        return;
+    }
+
+    /*
+
+        If the node we need to remove is the head node,
+        then remove the head node, and set the node after
+        it as head.
+
+    */
+    if (Index == 0) {
+
+        // Get our node to move
+        Node *ToMove = list->Head->Next;
+
+        // Remove Head Node
+        free(list->Head);
+
+        // Remove reference to head node stored in the
+        // node next to it (if there is none, the list is empty now)
+        if (ToMove != NULL)
+            ToMove->Last = NULL;
+        else
+            list->Tail = NULL;
+
+        // Set our ToMove node as list's head
+        list->Head = ToMove;
+
+        // Now, if the Cursor is pointing to head,
+        // we don't want to mess it up, so we fix it.
+        // Otherwise its node moved down by one.
+        if (list->Cursor == 0)
+            list->NodeAtCursor = ToMove;
+        else
+            list->Cursor--;
+
+    }
+
+        /*
+
+            If the node we need to remove is the tail node,
+            then remove the tail node, and set the node after
+            it as tail.
+
+        */
+
+    else if (Index == list->Size - 1) {
+
+        // Get our node to move
+        Node *ToMove = list->Tail->Last;
+
+        // Remove Tail Node
+        free(list->Tail);
+
+        // Remove reference to tail node stored in the
+        // node before it
+        ToMove->Next = NULL;
+
+        // Set our ToMove node as list's tail
+        list->Tail = ToMove;
+
+        // Now, if the Cursor is pointing to tail,
+        // we don't want to mess it up, so we fix it.
+        if (list->Cursor == list->Size - 1) {
+            list->NodeAtCursor = ToMove;
+            list->Cursor--;
+        }
+
+    }
+
+        /*
+
+            If the node we need to remove is somewhere
+            located between head and tail, we need to
+            find the node and remove it.
+
+        */
+
+    else {
+
+
+        Node *ToRemove = get(list, Index);
+        Node *Before = ToRemove->Last;
+        Node *After = ToRemove->Next;
+
+        // Interconnecting Node Before and After
+        // Ghosting ToRemove Node from the list.
+        Before->Next = After;
+        After->Last = Before;
+
+        // get left the cursor on ToRemove, so move it to the node taking its place.
+        // Otherwise, if the cursor was after it, its node moved down by one.
+        if (list->Cursor == Index)
+            list->NodeAtCursor = After;
+        else if (list->Cursor > Index)
+            list->Cursor--;
+
+        // Deleting Node
+        free(ToRemove);
+
+    }
+
+    // Checkpoints after the removed node moved down by one, and its own checkpoint is gone
+    shiftCheckpointsAfterRemove(list, Index);
+
+    list->Size--;
+
+    TRACE_END(list, LIST_REMOVE_AT_INDEX);
+}
+
+
+/*
+
+    static void emptyList(LinkedList *list, int FreeValues)
+
+    Frees all the nodes of the list, and the values as well if FreeValues is NON - ZERO.
+
+*/
+
+static void emptyList(LinkedList *list, int FreeValues) {
+
+    // Array storage, GC the values, and keep the array
+    if (list->Array != NULL) {
+
+        if (FreeValues)
+            for (int i = 0; i < list->Size; ++i)
+                free(list->Array[i]);
+
+        list->Size = 0;
+        list->Cursor = 0;
+
+        return;
+    }
+
+    // Get first node
+    Node *curNode = list->Head;
+
+    // To store reference to next node
+    Node *NextNode;
+
+    while (curNode != NULL) {
+        NextNode = curNode->Next;
+
+        // GC Data Stored in the Node
+        if (FreeValues)
+            free(curNode->Value);
+
+        // GC Node
+        free(curNode);
+
+        // Assign Node
+        curNode = NextNode;
+
+    }
+
+    list->Head = NULL;
+    list->Tail = NULL;
+    list->NodeAtCursor = NULL;
+
+    list->Size = 0;
+    list->Cursor = 0;
+
+    // Every checkpoint pointed to a node that's gone
+    list->CheckpointCount = 0;
+    list->CheckpointsStale = 1;
+
+}
+
+/*
+
+    static void destroyList(LinkedList *list, int FreeValues)
+
+    Clears the list, and deletes it.
+
+*/
+
+static void destroyList(LinkedList *list, int FreeValues) {
+
+    // Clear all elements in the list.
+    emptyList(list, FreeValues);
+
+    // Forget about it in the registry
+    unregisterList(list);
+
+    // Delete Checkpoints, and the Array
+    free(list->Checkpoints);
+    free(list->Array);
+
+    // Delete List
+    free(list);
+}
+
+/*
+
+    void clearList(LinkedList *list)
+
+    Clears all elements in the list, and collects garbage.
+
+*/
+
+void clearList(LinkedList *list) {
+    emptyList(list, 1);
+}
+
+/*
+
+    void clearListKeepValues(LinkedList *list)
+
+    Clears all elements in the list, but leaves the values alone.
+
+*/
+
+void clearListKeepValues(LinkedList *list) {
+    emptyList(list, 0);
+}
+
+
+/*
+
+    void deleteList(LinkedList *list)
+
+    Completely clears all the elements in the list,
+    and deletes the list.
+
+*/
+
+void deleteList(LinkedList *list) {
+    destroyList(list, 1);
+}
+
+/*
+
+    void deleteListKeepValues(LinkedList *list)
+
+    Deletes the nodes and the list, but leaves the values alone.
+
+*/
+
+void deleteListKeepValues(LinkedList *list) {
+    destroyList(list, 0);
+}
+
+/*
+
+    Algorithms
+
+*/
+
+
+/*
+
+    void forEachElementInList(LinkedList *list, void(*f)(void*))
+
+    Apply the function f to the elements of the list passed. On each iteration
+    the function f is passed the value of that element in the list.
+
+    Yeah, I stole it from Java, GOT A PROBLEM BRO?
+
+ */
+
+void forEachElementInList(LinkedList *list, void(*f)(void *)) {
+
+    // Array storage, straight through the array
+    if (list->Array != NULL) {
+
+        for (int i = 0; i < list->Size; ++i)
+            f(list->Array[i]);
+
+        return;
+    }
+
+    // Get Start Node
+    Node *curNode = list->Head;
+
+    // Iterate through all Nodes
+    while (curNode != NULL) {
+        f(curNode->Value);
+        curNode = curNode->Next;
+    }
+
+}
+
+/*
+
+    void forEachElementInListUpTo(LinkedList *list, int Count, void(*f)(void*))
+
+    Apply the function f to the first Count elements of the list.
+
+    We never read the Next of the last node we visit, because a thread
+    appending to the list might be writing to it right now.
+
+ */
+
+void forEachElementInListUpTo(LinkedList *list, int Count, void(*f)(void *)) {
+
+    if (Count <= 0)
+        return;
+
+    // Array storage, straight through the array
+    if (list->Array != NULL) {
+
+        for (int i = 0; i < Count; ++i)
+            f(list->Array[i]);
+
+        return;
+    }
+
+    // Get Start Node
+    Node *curNode = list->Head;
+
+    for (int i = 0; ; ++i) {
+
+        f(curNode->Value);
+
+        // Stop before touching the Next of the last node
+        if (i + 1 == Count)
+            break;
+
+        curNode = curNode->Next;
+    }
+
+}
+
+/*
+
+    void BinarySearch(LinkedList *list, int(*Evaluate)(void* Value,unsigned short int* MoveRight),void *Destination, int *Index)
+
+    Perform a Binary Search on the list, applies the function Evaluate on the indexed element to evaluate it.
+    Once evaluated, it will return assigned *Destination the value of the node, and *Index the index of the node.
+    Target, Value and a pointer MoveRight is passed on to the function Evaluate.
+    Evaluate Function MUST RETURN NON - ZERO VALUE IF TRUE, IT SHOULD RETURN ZERO IF FALSE
+    Evaluate Function MUST SET MOVE RIGHT TO NON - ZERO VALUE IF BINARY SEARCH SHOUlD MOVE RIGHT,
+    OR TO ZERO IF BINARY SEARCH SHOULD MOVE LEFT
+
+ */
+void
+BinarySearch(LinkedList *list, void *Target, int(*Evaluate)(void *Value, void *Target, unsigned short int *MoveRight),
+             void *Destination, int *Index) {
+
+    TRACE_BEGIN(list, LIST_BINARY_SEARCH);
+
+    // Binary Search Algorithm
+
+    int Start = 0;
+    int End = getListSize(list) - 1;
+
+    void *Value = NULL;
+    unsigned short int MoveRight = 0;
+
+    // Run until Middle is less than or equal to Size
+    while (Start <= End) {
+
+        // Get the Middle
+        int Middle = Start + (End - Start) / 2;
+
+        // Get Middle Value (through getValue, so it's not traced as a separate getFromList,
+        // but still weighed, so Adaptive Storage sees the search)
+        weighGet(list, Middle);
+        Value = getValue(list, Middle);
+
+        // If Evaluated, set Destination and Index values, break out of loop
+        if (Evaluate(Value, Target, &MoveRight)) {
+            Destination = Value;
+            *Index = Middle;
+            break;
+        }
+
+
+        // If Move Right
+        if (MoveRight)
+            //Ignore left
+            Start = Middle + 1;
+        else
+            //Ignore right
+            End = Middle - 1;
+
+    }
+
+    TRACE_END(list, LIST_BINARY_SEARCH);
+}
+
+/*
+
+    Searching
+
+    Finding a value used to mean calling forEachElementInList, and comparing
+    every value in a callback. Instead, we compare in place, without a call per value.
+
+    When Adaptive Storage has put the values in an array, they sit next to each other,
+    and we compare several at once with SSE2 or AVX2, picked at runtime. Keys are copied
+    out of FIND_BLOCK values at a time first. CPUs without them get a plain loop.
+
+    On nodes, waiting for the next node is what takes the time, not comparing
+    (bench/FindBench.c measured copying nodes into blocks for the kernels
+    no faster than the plain loop), so nodes are just walked and compared.
+
+ */
+
+// Number of nodes compared at once
+#define FIND_BLOCK 16
+
+/*
+
+    static int findPointerScalar(void **Values, int Count, void *Target)
+    static int findIntScalar(int *Keys, int Count, int Target)
+
+    Plain loops, for CPUs without SSE2 or AVX2, and for the leftovers
+    at the end of the vector loops.
+
+    Return the position of Target in the block, or -1.
+
+ */
+
+static int findPointerScalar(void **Values, int Count, void *Target) {
+
+    for (int i = 0; i < Count; ++i)
+        if (Values[i] == Target)
+            return i;
+
+    return -1;
+}
+
+static int findIntScalar(int *Keys, int Count, int Target) {
+
+    for (int i = 0; i < Count; ++i)
+        if (Keys[i] == Target)
+            return i;
+
+    return -1;
+}
+
+#ifdef FIND_SIMD
+
+/*
+
+    static int findPointerSSE2(void **Values, int Count, void *Target)
+
+    Compares 2 pointers per instruction. SSE2 can't compare 64 bit integers,
+    so we compare both 32 bit halves, and a pointer matches when both halves do.
+
+ */
+
+__attribute__((target("sse2")))
+static int findPointerSSE2(void **Values, int Count, void *Target) {
+
+    __m128i Wanted = _mm_set1_epi64x((long long) Target);
+
+    int i = 0;
+
+    for (; i + 2 <= Count; i += 2) {
+
+        __m128i Halves = _mm_cmpeq_epi32(_mm_loadu_si128((__m128i *) (Values + i)), Wanted);
+
+        // Swap the halves of each pointer, and AND them, so both halves have to match
+        __m128i Both = _mm_and_si128(Halves, _mm_shuffle_epi32(Halves, _MM_SHUFFLE(2, 3, 0, 1)));
+
+        int Mask = _mm_movemask_pd(_mm_castsi128_pd(Both));
+
+        if (Mask)
+            return i + __builtin_ctz(Mask);
+    }
+
+    int Found = findPointerScalar(Values + i, Count - i, Target);
+
+    return Found < 0 ? -1 : i + Found;
+}
+
+/*
+
+    static int findPointerAVX2(void **Values, int Count, void *Target)
+
+    Compares 4 pointers per instruction, 8 per iteration.
+
+ */
+
+__attribute__((target("avx2")))
+static int findPointerAVX2(void **Values, int Count, void *Target) {
+
+    __m256i Wanted = _mm256_set1_epi64x((long long) Target);
+
+    int i = 0;
+
+    for (; i + 8 <= Count; i += 8) {
+
+        __m256i Low = _mm256_cmpeq_epi64(_mm256_loadu_si256((__m256i *) (Values + i)), Wanted);
+        __m256i High = _mm256_cmpeq_epi64(_mm256_loadu_si256((__m256i *) (Values + i + 4)), Wanted);
+
+        int Mask = _mm256_movemask_pd(_mm256_castsi256_pd(Low)) |
+                   (_mm256_movemask_pd(_mm256_castsi256_pd(High)) << 4);
+
+        if (Mask)
+            return i + __builtin_ctz(Mask);
+    }
+
+    int Found = findPointerScalar(Values + i, Count - i, Target);
+
+    return Found < 0 ? -1 : i + Found;
+}
+
+/*
+
+    static int findIntSSE2(int *Keys, int Count, int Target)
+
+    Compares 4 keys per instruction.
+
+ */
+
+__attribute__((target("sse2")))
+static int findIntSSE2(int *Keys, int Count, int Target) {
+
+    __m128i Wanted = _mm_set1_epi32(Target);
+
+    int i = 0;
+
+    for (; i + 4 <= Count; i += 4) {
+
+        __m128i Equal = _mm_cmpeq_epi32(_mm_loadu_si128((__m128i *) (Keys + i)), Wanted);
+
+        int Mask = _mm_movemask_ps(_mm_castsi128_ps(Equal));
+
+        if (Mask)
+            return i + __builtin_ctz(Mask);
+    }
+
+    int Found = findIntScalar(Keys + i, Count - i, Target);
+
+    return Found < 0 ? -1 : i + Found;
+}
+
+/*
+
+    static int findIntAVX2(int *Keys, int Count, int Target)
+
+    Compares 8 keys per instruction.
+
+ */
+
+__attribute__((target("avx2")))
+static int findIntAVX2(int *Keys, int Count, int Target) {
+
+    __m256i Wanted = _mm256_set1_epi32(Target);
+
+    int i = 0;
+
+    for (; i + 8 <= Count; i += 8) {
+
+        __m256i Equal = _mm256_cmpeq_epi32(_mm256_loadu_si256((__m256i *) (Keys + i)), Wanted);
+
+        int Mask = _mm256_movemask_ps(_mm256_castsi256_ps(Equal));
+
+        if (Mask)
+            return i + __builtin_ctz(Mask);
+    }
+
+    int Found = findIntScalar(Keys + i, Count - i, Target);
+
+    return Found < 0 ? -1 : i + Found;
+}
+
+#endif
+
+/*
+
+    static int (*pickPointerKernel())(void **Values, int Count, void *Target)
+    static int (*pickIntKernel())(int *Keys, int Count, int Target)
+
+    Pick the widest kernel the CPU running us supports.
+
+ */
+
+static int (*pickPointerKernel())(void **Values, int Count, void *Target) {
+
+#ifdef FIND_SIMD
+    if (__builtin_cpu_supports("avx2"))
+        return findPointerAVX2;
+
+    if (__builtin_cpu_supports("sse2"))
+        return findPointerSSE2;
+#endif
+
+    return findPointerScalar;
+}
+
+static int (*pickIntKernel())(int *Keys, int Count, int Target) {
+
+#ifdef FIND_SIMD
+    if (__builtin_cpu_supports("avx2"))
+        return findIntAVX2;
+
+    if (__builtin_cpu_supports("sse2"))
+        return findIntSSE2;
+#endif
+
+    return findIntScalar;
+}
+
+/*
+
+    static int foundAt(LinkedList *list, Node *node, int Index)
+
+    Moves the cursor to the node we found, and returns its index.
+
+ */
+
+static int foundAt(LinkedList *list, Node *node, int Index) {
+
+    list->Cursor = Index;
+    list->NodeAtCursor = node;
+
+    return Index;
+}
+
+/*
+
+    int findValueInList(LinkedList *list, void *Value)
+
+    Finds the first element that is the same pointer as Value.
+
+ */
+
+int findValueInList(LinkedList *list, void *Value) {
+
+    int (*Kernel)(void **Values, int Count, void *Target) = pickPointerKernel();
+
+    // Array storage, the values already sit next to each other, no need for blocks
+    if (list->Array != NULL) {
+
+        int Found = Kernel(list->Array, list->Size, Value);
+
+        if (Found >= 0)
+            list->Cursor = Found;
+
+        return Found;
+    }
+
+    // Node storage, the walk from node to node is the slow part, not the comparison,
+    // so copying values into blocks for the kernel doesn't pay off. Just compare as we go.
+    int Index = 0;
+
+    for (Node *curNode = list->Head; curNode != NULL; curNode = curNode->Next, ++Index)
+        if (curNode->Value == Value)
+            return foundAt(list, curNode, Index);
+
+    return -1;
+}
+
+/*
+
+    int findKeyInList(LinkedList *list, size_t KeyOffset, int Key)
+
+    Finds the first element whose value holds Key, KeyOffset bytes into it.
+
+ */
+
+int findKeyInList(LinkedList *list, size_t KeyOffset, int Key) {
+
+    int (*Kernel)(int *Keys, int Count, int Target) = pickIntKernel();
+
+    // Array storage, the keys still have to be copied out of the values, block by block
+    if (list->Array != NULL) {
+
+        int Block[FIND_BLOCK];
+
+        for (int Start = 0; Start < list->Size; Start += FIND_BLOCK) {
+
+            int Count = list->Size - Start < FIND_BLOCK ? list->Size - Start : FIND_BLOCK;
+
+            for (int i = 0; i < Count; ++i)
+                Block[i] = *(int *) ((char *) list->Array[Start + i] + KeyOffset);
+
+            int Found = Kernel(Block, Count, Key);
+
+            if (Found >= 0) {
+                list->Cursor = Start + Found;
+                return Start + Found;
+            }
+        }
+
+        return -1;
+    }
+
+    // Node storage, compare as we go, just like findValueInList
+    int Index = 0;
+
+    for (Node *curNode = list->Head; curNode != NULL; curNode = curNode->Next, ++Index)
+        if (*(int *) ((char *) curNode->Value + KeyOffset) == Key)
+            return foundAt(list, curNode, Index);
+
+    return -1;
+}
+
+/*
+
+    Sorted List Operations
+
+    Combining two sorted lists by calling getFromList in nested loops,
+    and allocating a new node for every value with addToList, is slow.
+
+    Since both lists are sorted, we can walk both of them once, side by side,
+    always looking at the smaller of the two values. And since we own the nodes,
+    we can simply relink them instead of allocating new ones.
+
+ */
+
+// To know which operation we are performing
+#define UNION 0
+#define INTERSECTION 1
+#define DIFFERENCE 2
+
+/*
+
+    static Node *detachNodes(LinkedList *list)
+
+    Takes all the nodes away from the list, and returns the first one.
+    The list is left empty, but the nodes are still linked to each other.
+
+ */
+
+static Node *detachNodes(LinkedList *list) {
+
+    Node *Head = list->Head;
+
+    list->Head = NULL;
+    list->Tail = NULL;
+    list->NodeAtCursor = NULL;
+
+    list->Size = 0;
+    list->Cursor = 0;
+
+    // The nodes are about to be rearranged
+    list->CheckpointCount = 0;
+    list->CheckpointsStale = 1;
+
+    return Head;
+}
+
+/*
+
+    static void linkToTail(LinkedList *list, Node *node)
+
+    Same as addToList, but links an existing node instead
+    of allocating a new one.
+
+ */
+
+static void linkToTail(LinkedList *list, Node *node) {
+
+    node->Next = NULL;
+    node->Last = list->Tail;
+
+    // If it's the first node, it's the head, and the cursor points to it
+    if (list->Tail == NULL) {
+        list->Head = node;
+        list->NodeAtCursor = node;
+        list->Cursor = 0;
+    } else
+        list->Tail->Next = node;
+
+    list->Tail = node;
+    list->Size++;
+}
+
+/*
+
+    static void keepNode(LinkedList *Destination, Node *node, int ReuseNodes)
+
+    Puts the node's value at the end of Destination, either by moving
+    the node itself, or by adding a new node with the same value.
+
+ */
+
+static void keepNode(LinkedList *Destination, Node *node, int ReuseNodes) {
+
+    if (ReuseNodes)
+        linkToTail(Destination, node);
+    else
+        addToList(Destination, node->Value);
+}
+
+/*
+
+    static void leaveNode(LinkedList *Source, Node *node, int ReuseNodes)
+
+    When reusing nodes, the source lists were emptied, so the nodes that are
+    left out go back to their source, in the same order as before.
+
+ */
+
+static void leaveNode(LinkedList *Source, Node *node, int ReuseNodes) {
+
+    if (ReuseNodes)
+        linkToTail(Source, node);
+}
+
+/*
+
+    void mergeSortedLists(LinkedList *list, LinkedList *other, int(*Compare)(void *A, void *B))
+
+    Merges other into list, by relinking the nodes of both lists.
+
+ */
+
+void mergeSortedLists(LinkedList *list, LinkedList *other, int(*Compare)(void *A, void *B)) {
+
+    // Relinking needs nodes
+    useNodeStorage(list);
+    useNodeStorage(other);
+
+    Node *A = detachNodes(list);
+    Node *B = detachNodes(other);
+
+    // To store reference to next node
+    Node *NextNode;
+
+    // Always link the smaller value, <= so that equal values from list come first
+    while (A != NULL && B != NULL) {
+
+        if (Compare(A->Value, B->Value) <= 0) {
+            NextNode = A->Next;
+            linkToTail(list, A);
+            A = NextNode;
+        } else {
+            NextNode = B->Next;
+            linkToTail(list, B);
+            B = NextNode;
+        }
+
+    }
+
+    // One of the lists has run out, the rest of the other one is already sorted,
+    // so hook it on as it is.
+    Node *Rest = A != NULL ? A : B;
+
+    if (Rest != NULL) {
+
+        if (list->Tail == NULL) {
+            list->Head = Rest;
+            list->NodeAtCursor = Rest;
+        } else
+            list->Tail->Next = Rest;
+
+        Rest->Last = list->Tail;
+
+        // Still have to count the rest, and find the tail
+        while (Rest != NULL) {
+            list->Tail = Rest;
+            list->Size++;
+            Rest = Rest->Next;
+        }
+
+    }
+
+}
+
+/*
+
+    void concatenateLists(LinkedList *list, LinkedList *other)
+
+    Hooks other's chain of nodes onto list's tail.
+
+ */
+
+void concatenateLists(LinkedList *list, LinkedList *other) {
+
+    if (other->Size == 0)
+        return;
+
+    // Splicing needs nodes
+    useNodeStorage(list);
+    useNodeStorage(other);
+
+    int OtherSize = other->Size;
+    Node *OtherTail = other->Tail;
+
+    Node *OtherHead = detachNodes(other);
+
+    // If list is empty, it simply takes over other's nodes
+    if (list->Tail == NULL) {
+        list->Head = OtherHead;
+        list->NodeAtCursor = OtherHead;
+        list->Cursor = 0;
+    } else {
+        list->Tail->Next = OtherHead;
+        OtherHead->Last = list->Tail;
+    }
+
+    list->Tail = OtherTail;
+    list->Size += OtherSize;
+
+    // The checkpoints are still right, but the gap after the last one may be huge now
+    list->CheckpointsStale = 1;
+}
+
+/*
+
+    static LinkedList *combineSortedLists(LinkedList *list, LinkedList *other, int(*Compare)(void *A, void *B), int ReuseNodes, int Operation)
+
+    Walks list (A) and other (B) side by side, and decides for every value
+    whether it's kept in the result or left out, depending on the Operation:
+
+     -  Value only in A:     kept by UNION and DIFFERENCE
+     -  Value only in B:     kept by UNION
+     -  Value in both:       A's is kept by UNION and INTERSECTION, B's is always left out
+
+ */
+
+static LinkedList *combineSortedLists(LinkedList *list, LinkedList *other, int(*Compare)(void *A, void *B),
+                                      int ReuseNodes, int Operation) {
+
+    LinkedList *Result = newList();
+
+    // Walking side by side (and reusing) needs nodes
+    useNodeStorage(list);
+    useNodeStorage(other);
+
+    // When reusing nodes, the lists are emptied first, and get back what is left out
+    Node *A = ReuseNodes ? detachNodes(list) : list->Head;
+    Node *B = ReuseNodes ? detachNodes(other) : other->Head;
+
+    // Cache next nodes, because moving a node changes its Next
+    Node *NextA;
+    Node *NextB;
+
+    while (A != NULL && B != NULL) {
+
+        int Compared = Compare(A->Value, B->Value);
+
+        NextA = A->Next;
+        NextB = B->Next;
+
+        // Value only in A
+        if (Compared < 0) {
+
+            if (Operation == INTERSECTION)
+                leaveNode(list, A, ReuseNodes);
+            else
+                keepNode(Result, A, ReuseNodes);
+
+            A = NextA;
+        }
+
+            // Value only in B
+        else if (Compared > 0) {
 
-    This function returns a value from stored
-    in the node found at the index
+            if (Operation == UNION)
+                keepNode(Result, B, ReuseNodes);
+            else
+                leaveNode(other, B, ReuseNodes);
 
- */
+            B = NextB;
+        }
 
-void *getFromList(LinkedList *list, int Index) {
-    return get(list, Index)->Value;
-}
+            // Value in both
+        else {
 
-/*
+            if (Operation == DIFFERENCE)
+                leaveNode(list, A, ReuseNodes);
+            else
+                keepNode(Result, A, ReuseNodes);
+
+            leaveNode(other, B, ReuseNodes);
 
-    void addToListAtIndex(LinkedList *list, int Index)
+            A = NextA;
+            B = NextB;
+        }
 
-    Adds a new element to the list at a given index.
+    }
 
- */
+    // Whatever is left in A is only in A
+    while (A != NULL) {
 
-void addToListAtIndex(LinkedList *list, void *Value, int Index) {
+        NextA = A->Next;
 
-    if (Index < 0 || Index >= list->Size) {
-        printf("INDEX OUT OF BOUNDS EXCEPTION. ATTEMPT TO INDEX INVALID INDEX %i\n", Index);
-        exit(-1);
+        if (Operation == INTERSECTION)
+            leaveNode(list, A, ReuseNodes);
+        else
+            keepNode(Result, A, ReuseNodes);
+
+        A = NextA;
     }
 
-    Node *newNode = (Node *) malloc(sizeof(struct Node));
-    newNode->Value = Value;
-    newNode->Next = NULL;
-    newNode->Last = NULL;
+    // Whatever is left in B is only in B
+    while (B != NULL) {
 
-    Node *CurNode = NULL;
-    Node *NodeBefore = NULL;
+        NextB = B->Next;
 
+        if (Operation == UNION)
+            keepNode(Result, B, ReuseNodes);
+        else
+            leaveNode(other, B, ReuseNodes);
 
-    // If Index is 0, adding the node at the start of the list.
-    if (Index == 0) {
+        B = NextB;
+    }
 
-        // Cache head node's reference to CurNode
-        CurNode = list->Head;
+    return Result;
+}
 
-        // Set Head Node's Last Node Value to new node
-        CurNode->Last = newNode;
+/*
 
-        // Set new node's next value to head node ( connecting each other )
-        newNode->Next = CurNode;
+    LinkedList *unionOfSortedLists(LinkedList *list, LinkedList *other, int(*Compare)(void *A, void *B), int ReuseNodes)
 
-        // Now set list's head to new node, because that's our new head node now right?
-        list->Head = newNode;
+    Returns the values found in list or other.
 
-    }
+ */
 
-        // If Index is the last index, adding the node at the end of the list.
-    else if (Index == list->Size - 1) {
+LinkedList *unionOfSortedLists(LinkedList *list, LinkedList *other, int(*Compare)(void *A, void *B), int ReuseNodes) {
+    return combineSortedLists(list, other, Compare, ReuseNodes, UNION);
+}
 
-        // Cache tail node's reference to CurNode
-        CurNode = list->Tail;
+/*
 
-        // Set Tail Node's Next Value to new node
-        CurNode->Next = newNode;
+    LinkedList *intersectionOfSortedLists(LinkedList *list, LinkedList *other, int(*Compare)(void *A, void *B), int ReuseNodes)
 
-        // Set new node's last value to head node ( connecting each other )
-        newNode->Last = CurNode;
+    Returns the values of list also found in other.
 
-        // Now set list's tail to new node, because that's our new tail node now right?
-        list->Tail = newNode;
+ */
 
-    }
+LinkedList *intersectionOfSortedLists(LinkedList *list, LinkedList *other, int(*Compare)(void *A, void *B),
+                                      int ReuseNodes) {
+    return combineSortedLists(list, other, Compare, ReuseNodes, INTERSECTION);
+}
 
-        //Well, if the index is somewhere between, we need to find the particular node at index now.
-    else {
+/*
 
-        // Cache reference to the node once we find it.
-        CurNode = get(list, Index);
+    LinkedList *differenceOfSortedLists(LinkedList *list, LinkedList *other, int(*Compare)(void *A, void *B), int ReuseNodes)
 
-        // Cache reference to the node before it after we find it.
-        NodeBefore = get(list, Index - 1);
+    Returns the values of list NOT found in other.
 
-        // NB NN <- CN
-        // (NB: NodeBefore, NN: NewNode, CN: CurNode, Connections: - or =, Direction: < or > )
+ */
 
-        // Now set CurNode's last value to our new node.
-        CurNode->Last = newNode;
+LinkedList *differenceOfSortedLists(LinkedList *list, LinkedList *other, int(*Compare)(void *A, void *B),
+                                    int ReuseNodes) {
+    return combineSortedLists(list, other, Compare, ReuseNodes, DIFFERENCE);
+}
 
-        // NB NN <=> CN
+/*
 
-        // Now set newNode's next to CurNode
-        newNode->Next = CurNode;
+    Memory Usage
 
-        // NB -> NN <=> CN
+ */
 
-        // Now set NodeBefore's next to cur node
-        NodeBefore->Next = newNode;
+/*
 
-        // NB <=> NN <=> CN
+    static size_t allocatorOverhead(size_t Bytes)
 
-        // Now set curNode's last to NodeBefore
-        newNode->Last = CurNode;
+    Estimates how many bytes malloc loses on an allocation of Bytes.
+    Typical mallocs (glibc's included) put a size_t header in front of every
+    allocation, round the whole chunk up to two size_t's, and never hand out
+    a chunk smaller than four size_t's.
 
-    }
+ */
 
-    // Making sure our NodeAtCursor is not corrupted while adding nodes
-    if (list->Cursor == Index)
-        list->NodeAtCursor = newNode;
+static size_t allocatorOverhead(size_t Bytes) {
 
-    //Incrementing List Size
-    list->Size++;
+    size_t Alignment = 2 * sizeof(size_t);
+    size_t Chunk = (Bytes + sizeof(size_t) + Alignment - 1) / Alignment * Alignment;
 
+    if (Chunk < 4 * sizeof(size_t))
+        Chunk = 4 * sizeof(size_t);
+
+    return Chunk - Bytes;
 }
 
 /*
 
-    void removeFromListAtIndex(LinkedList *list, int Index);
+    static void addListMemoryUsage(LinkedList *list, ListMemoryReport *Report, size_t(*SizeOfValue)(void *Value))
 
-    To Remove a value from the list
+    Adds the memory held by the list on top of what's already in Report.
 
-*/
+ */
 
-void removeFromListAtIndex(LinkedList *list, int Index) {
+static void addListMemoryUsage(LinkedList *list, ListMemoryReport *Report, size_t(*SizeOfValue)(void *Value)) {
 
-    if (Index < 0 || Index >= list->Size) {
-        printf("INDEX OUT OF BOUNDS EXCEPTION. ATTEMPT TO INDEX INVALID INDEX %i\n", Index);
-        exit(-1);
-    }
+    // No nodes when the values are stored in an array
+    size_t Nodes = list->Array != NULL ? 0 : (size_t) list->Size;
 
-    /*
+    Report->ListCount++;
+    Report->NodeCount += Nodes;
 
-        If the node we need to remove is the head node,
-        then remove the head node, and set the node after
-        it as head.
+    Report->ListBytes += sizeof(struct LinkedList);
+    Report->NodeBytes += Nodes * sizeof(struct Node);
 
-    */
-    if (Index == 0) {
+    Report->AllocatorOverheadBytes += allocatorOverhead(sizeof(struct LinkedList));
+    Report->AllocatorOverheadBytes += Nodes * allocatorOverhead(sizeof(struct Node));
 
-        // Get our node to move
-        Node *ToMove = list->Head->Next;
+    // The array, when stored as one
+    if (list->Array != NULL) {
+        size_t ArrayBytes = list->ArrayCapacity * sizeof(void *);
 
-        // Remove Head Node
-        free(list->Head);
+        Report->ArrayBytes += ArrayBytes;
+        Report->AllocatorOverheadBytes += allocatorOverhead(ArrayBytes);
+    }
 
-        // Remove reference to head node stored in the
-        // node next to it
-        ToMove->Last = NULL;
+    // The Express Lane's checkpoints
+    if (list->Checkpoints != NULL) {
+        size_t CheckpointBytes = list->CheckpointCapacity * sizeof(struct Checkpoint);
 
-        // Set our ToMove node as list's head
-        list->Head = ToMove;
+        Report->IndexBytes += CheckpointBytes;
+        Report->AllocatorOverheadBytes += allocatorOverhead(CheckpointBytes);
+    }
 
-        // Now, if the Cursor is pointing to head,
-        // we don't want to mess it up, so we fix it.
-        if (list->Cursor == HEAD)
-            list->NodeAtCursor = ToMove;
+    // The values are the only thing we have to walk the list for
+    if (SizeOfValue != NULL && list->Array != NULL) {
+
+        for (int i = 0; i < list->Size; ++i)
+            Report->ValueBytes += SizeOfValue(list->Array[i]);
+
+    } else if (SizeOfValue != NULL) {
+
+        Node *curNode = list->Head;
+
+        while (curNode != NULL) {
+            Report->ValueBytes += SizeOfValue(curNode->Value);
+            curNode = curNode->Next;
+        }
 
     }
 
-        /*
+    Report->TotalBytes = Report->ListBytes + Report->NodeBytes + Report->ArrayBytes + Report->IndexBytes +
+                         Report->AllocatorOverheadBytes + Report->ValueBytes;
+}
 
-            If the node we need to remove is the tail node,
-            then remove the tail node, and set the node after
-            it as tail.
+/*
 
-        */
+    static void clearReport(ListMemoryReport *Report)
 
-    else if (Index == list->Size - 1) {
+    Sets everything in the report to zero.
 
-        // Get our node to move
-        Node *ToMove = list->Tail->Last;
+ */
 
-        // Remove Tail Node
-        free(list->Tail);
+static void clearReport(ListMemoryReport *Report) {
+
+    Report->ListCount = 0;
+    Report->NodeCount = 0;
+    Report->ListBytes = 0;
+    Report->NodeBytes = 0;
+    Report->ArrayBytes = 0;
+    Report->IndexBytes = 0;
+    Report->AllocatorOverheadBytes = 0;
+    Report->ValueBytes = 0;
+    Report->TotalBytes = 0;
+}
 
-        // Remove reference to tail node stored in the
-        // node before it
-        ToMove->Next = NULL;
+/*
 
-        // Set our ToMove node as list's tail
-        list->Tail = ToMove;
+    void getListMemoryUsage(LinkedList *list, ListMemoryReport *Report, size_t(*SizeOfValue)(void *Value))
 
-        // Now, if the Cursor is pointing to tail,
-        // we don't want to mess it up, so we fix it.
-        if (list->Cursor == list->Size - 1)
-            list->NodeAtCursor = ToMove;
+    Fills Report with the memory held by the list.
 
-    }
+ */
 
-        /*
+void getListMemoryUsage(LinkedList *list, ListMemoryReport *Report, size_t(*SizeOfValue)(void *Value)) {
 
-            If the node we need to remove is somewhere
-            located between head and tail, we need to
-            find the node and remove it.
+    clearReport(Report);
 
-        */
+    addListMemoryUsage(list, Report, SizeOfValue);
+}
 
-    else {
+/*
 
+    void getAllListsMemoryUsage(ListMemoryReport *Report, size_t(*SizeOfValue)(void *Value))
 
-        Node *ToRemove = get(list, Index);
-        Node *Before = ToRemove->Last;
-        Node *After = ToRemove->Next;
+    Fills Report with the memory held by every live list.
 
-        // Interconnecting Node Before and After
-        // Ghosting ToRemove Node from the list.
-        Before->Next = After;
-        After->Last = Before;
+ */
 
-        // Deleting Node
-        free(ToRemove);
+void getAllListsMemoryUsage(ListMemoryReport *Report, size_t(*SizeOfValue)(void *Value)) {
 
-    }
+    clearReport(Report);
 
-    list->Size--;
-}
+    LOCK_REGISTRY();
+
+    for (LinkedList *list = LiveLists; list != NULL; list = list->NextLive)
+        addListMemoryUsage(list, Report, SizeOfValue);
 
+    UNLOCK_REGISTRY();
+}
 
 /*
 
-    void clearList(LinkedList *list)
+    int getLiveListCount()
 
-    Clears all elements in the list, and collects garbage.
+    Returns the number of live lists.
 
-*/
+ */
 
-void clearList(LinkedList *list) {
+int getLiveListCount() {
 
-    // Get first node
-    Node *curNode = list->Head;
+    LOCK_REGISTRY();
 
-    // To store reference to next node
-    Node *NextNode;
+    int Count = LiveListCount;
 
-    while (curNode != NULL) {
-        NextNode = curNode->Next;
+    UNLOCK_REGISTRY();
 
-        // GC Data Stored in the Node
-        free(curNode->Value);
+    return Count;
+}
 
-        // GC Node
-        free(curNode);
+/*
 
-        // Assign Node
-        curNode = NextNode;
+    void forEachLiveList(void(*f)(LinkedList *list, void *UserData), void *UserData)
 
-    }
+    Apply the function f to every live list.
 
-    list->Head = NULL;
-    list->Tail = NULL;
-    list->NodeAtCursor = NULL;
+ */
 
-    list->Size = 0;
-    list->Cursor = 0;
+void forEachLiveList(void(*f)(LinkedList *list, void *UserData), void *UserData) {
+
+    LOCK_REGISTRY();
+
+    for (LinkedList *list = LiveLists; list != NULL; list = list->NextLive)
+        f(list, UserData);
 
+    UNLOCK_REGISTRY();
 }
 
+#ifdef LINKEDLIST_TRACING
 
 /*
 
-    void deleteList(LinkedList *list)
+    Tracing
 
-    Completely clears all the elements in the list,
-    and deletes the list.
+ */
 
-*/
+// Names of the traced operations, in the order of ListOperation
+static const char *OperationNames[LIST_OPERATION_COUNT] = {
+        "addToList",
+        "getFromList",
+        "addToListAtIndex",
+        "removeFromListAtIndex",
+        "BinarySearch"
+};
 
-void deleteList(LinkedList *list) {
+/*
 
-    // Clear all elements in the list.
-    clearList(list);
+    void setListTraceHooks(LinkedList *list, ListTraceHook Begin, ListTraceHook End, void *UserData)
 
-    // Delete List
-    free(list);
+    Registers the hooks called before and after every traced operation.
+
+ */
 
-    // Assign Pointer to Null
-    list = NULL;
+void setListTraceHooks(LinkedList *list, ListTraceHook Begin, ListTraceHook End, void *UserData) {
+    list->TraceBegin = Begin;
+    list->TraceEnd = End;
+    list->TraceUserData = UserData;
 }
 
 /*
 
-    Algorithms
+    long long getListLatencyPercentile(LinkedList *list, ListOperation Operation, double Percentile)
 
-*/
+    Walks the buckets until Percentile percent of the calls are counted,
+    and returns the top of that bucket (or the slowest call, if that's lower).
 
+ */
 
-/*
+long long getListLatencyPercentile(LinkedList *list, ListOperation Operation, double Percentile) {
 
-    void forEachElementInList(LinkedList *list, void(*f)(void*))
+    LatencyHistogram *Histogram = &list->Latency[Operation];
 
-    Apply the function f to the elements of the list passed. On each iteration
-    the function f is passed the value of that element in the list.
+    if (Histogram->Count == 0)
+        return 0;
 
-    Yeah, I stole it from Java, GOT A PROBLEM BRO?
+    // Number of calls that have to be under the result
+    double Wanted = Histogram->Count * Percentile / 100.0;
 
- */
+    unsigned long long Counted = 0;
 
-void forEachElementInList(LinkedList *list, void(*f)(void *)) {
+    for (int i = 0; i < LATENCY_BUCKETS; ++i) {
 
-    // Get Start Node
-    Node *curNode = list->Head;
+        Counted += Histogram->Buckets[i];
 
-    // Iterate through all Nodes
-    while (curNode != NULL) {
-        f(curNode->Value);
-        curNode = curNode->Next;
+        if (Counted >= Wanted && Counted > 0) {
+
+            unsigned long long Top = i == 63 ? ~0ULL : (2ULL << i) - 1;
+
+            return (long long) (Top < Histogram->MaxNanos ? Top : Histogram->MaxNanos);
+        }
     }
 
+    return (long long) Histogram->MaxNanos;
 }
 
 /*
 
-    void BinarySearch(LinkedList *list, int(*Evaluate)(void* Value,unsigned short int* MoveRight),void *Destination, int *Index)
+    void dumpListLatency(LinkedList *list, FILE *Stream, int AsJson)
 
-    Perform a Binary Search on the list, applies the function Evaluate on the indexed element to evaluate it.
-    Once evaluated, it will return assigned *Destination the value of the node, and *Index the index of the node.
-    Target, Value and a pointer MoveRight is passed on to the function Evaluate.
-    Evaluate Function MUST RETURN NON - ZERO VALUE IF TRUE, IT SHOULD RETURN ZERO IF FALSE
-    Evaluate Function MUST SET MOVE RIGHT TO NON - ZERO VALUE IF BINARY SEARCH SHOUlD MOVE RIGHT,
-    OR TO ZERO IF BINARY SEARCH SHOULD MOVE LEFT
+    Writes the summary of every operation's histogram to Stream.
 
  */
-void
-BinarySearch(LinkedList *list, void *Target, int(*Evaluate)(void *Value, void *Target, unsigned short int *MoveRight),
-             void *Destination, int *Index) {
 
-    // Binary Search Algorithm
+void dumpListLatency(LinkedList *list, FILE *Stream, int AsJson) {
 
-    int Start = 0;
-    int End = getListSize(list) - 1;
+    if (AsJson)
+        fprintf(Stream, "{");
+    else
+        fprintf(Stream, "%-22s %10s %10s %10s %10s %10s %10s %10s\n",
+                "operation (ns)", "count", "mean", "min", "p50", "p90", "p99", "max");
 
-    void *Value = NULL;
-    unsigned short int MoveRight = 0;
+    for (int Operation = 0; Operation < LIST_OPERATION_COUNT; ++Operation) {
 
-    // Run until Middle is less than or equal to Size
-    while (Start <= End) {
+        LatencyHistogram *Histogram = &list->Latency[Operation];
 
-        // Get the Middle
-        int Middle = Start + (End - Start) / 2;
+        unsigned long long Count = Histogram->Count;
+        unsigned long long Mean = Count ? Histogram->TotalNanos / Count : 0;
+        unsigned long long Min = Count ? Histogram->MinNanos : 0;
 
-        // Get Middle Value
-        Value = getFromList(list, Middle);
+        long long P50 = getListLatencyPercentile(list, (ListOperation) Operation, 50);
+        long long P90 = getListLatencyPercentile(list, (ListOperation) Operation, 90);
+        long long P99 = getListLatencyPercentile(list, (ListOperation) Operation, 99);
 
-        // If Evaluated, set Destination and Index values, break out of loop
-        if (Evaluate(Value, Target, &MoveRight)) {
-            Destination = Value;
-            *Index = Middle;
-            break;
+        if (!AsJson) {
+            fprintf(Stream, "%-22s %10llu %10llu %10llu %10lld %10lld %10lld %10llu\n",
+                    OperationNames[Operation], Count, Mean, Min, P50, P90, P99, Histogram->MaxNanos);
+            continue;
         }
 
+        fprintf(Stream, "%s\"%s\":{\"count\":%llu,\"mean_ns\":%llu,\"min_ns\":%llu,"
+                        "\"p50_ns\":%lld,\"p90_ns\":%lld,\"p99_ns\":%lld,\"max_ns\":%llu,\"buckets\":[",
+                Operation ? "," : "", OperationNames[Operation], Count, Mean, Min, P50, P90, P99,
+                Histogram->MaxNanos);
 
-        // If Move Right
-        if (MoveRight)
-            //Ignore left
-            Start = Middle + 1;
-        else
-            //Ignore right
-            End = Middle - 1;
+        // Only up to the last bucket that has calls in it
+        int Last = LATENCY_BUCKETS - 1;
+
+        while (Last >= 0 && Histogram->Buckets[Last] == 0)
+            Last--;
 
+        for (int i = 0; i <= Last; ++i)
+            fprintf(Stream, "%s%llu", i ? "," : "", Histogram->Buckets[i]);
+
+        fprintf(Stream, "]}");
     }
 
+    if (AsJson)
+        fprintf(Stream, "}\n");
+}
+
+/*
+
+    void resetListLatency(LinkedList *list)
+
+    Empties all the histograms of the list.
+
+ */
+
+void resetListLatency(LinkedList *list) {
+
+    memset(list->Latency, 0, sizeof(list->Latency));
+
+    for (int Operation = 0; Operation < LIST_OPERATION_COUNT; ++Operation)
+        list->Latency[Operation].MinNanos = ~0ULL;
 }
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef LINKEDLIST_H
 #define LINKEDLIST_H
 
+#include <stddef.h>
+
 // Linked List Data Type
 typedef struct LinkedList LinkedList;
 
@@ -33,6 +35,67 @@ int getListSize(LinkedList *list);
 int getListCursorPosition(LinkedList *list);
 
 
+/*
+
+    void enableListExpressLane(LinkedList *list)
+
+    - Turns on the Express Lane: the list keeps a checkpoint on about every sqrt(n)-th node,
+      and getFromList starts from the closest one.
+    - Random access drops to O(sqrt(n)) Time, for O(sqrt(n)) Space.
+    - addToListAtIndex and removeFromListAtIndex update the checkpoints in O(sqrt(n)) Time,
+      and they are placed again from scratch (O(n)) after about sqrt(n) changes.
+    - addToList only adds a checkpoint on the tail every now and then, O(1) amortized Time.
+
+ */
+
+void enableListExpressLane(LinkedList *list);
+
+/*
+
+    void disableListExpressLane(LinkedList *list)
+
+    - Turns off the Express Lane, and frees its checkpoints.
+
+ */
+
+void disableListExpressLane(LinkedList *list);
+
+/*
+
+    void enableListAdaptiveStorage(LinkedList *list)
+
+    - Turns on Adaptive Storage: the list watches how it's used, and moves its values
+      between an array (O(1) getFromList, fast forEachElementInList and findValueInList)
+      and nodes (cheap addToListAtIndex and removeFromListAtIndex near the cursor or the head)
+      on its own. Everything else keeps working the same.
+    - It only moves once the other storage would have saved more than moving costs,
+      so it doesn't switch back and forth.
+    - Moving costs O(n) Time, spread over at least O(n) operations.
+
+ */
+
+void enableListAdaptiveStorage(LinkedList *list);
+
+/*
+
+    void disableListAdaptiveStorage(LinkedList *list)
+
+    - Turns off Adaptive Storage, and moves the values back into nodes.
+
+ */
+
+void disableListAdaptiveStorage(LinkedList *list);
+
+/*
+
+    int isListStoredAsArray(LinkedList *list)
+
+    - Returns non - zero if Adaptive Storage has the values in an array right now.
+
+ */
+
+int isListStoredAsArray(LinkedList *list);
+
 /*
 
     void addToList(LinkedList *list, void *Value)
@@ -56,9 +119,26 @@ void* getFromList(LinkedList *list, int Index);
 
 /*
 
-    void addToListAtIndex(LinkedList *list, int Index)
+    void getManyFromList(LinkedList *list, const int *Indices, int Count, void **Destination)
+
+    - Gets the values at all Count indices, Destination[i] is assigned the value at Indices[i].
+    - The indices are visited in ascending order (they are sorted internally if they aren't already),
+      so the cursor sweeps through the list once, instead of jumping around for each index.
+    - O(n + k log(k)) Time, O(k) Space (O(n + k) Time, O(1) Space if Indices are already sorted)
+
+ */
+
+void getManyFromList(LinkedList *list, const int *Indices, int Count, void **Destination);
+
+/*
+
+    void addToListAtIndex(LinkedList *list, void *Value, int Index)
 
-    - Adds a new element to the list at a given index.
+    - Adds a new element to the list at a given index: afterwards getFromList(list, Index)
+      returns Value, and the values from Index on move up by one.
+    - Index must be from 0 to Size - 1, to append after the tail use addToList.
+    - Older versions put the value after the tail for Index == Size - 1,
+      it now lands at Index like every other index.
     - O(1) to O(n) Time, O(1) Space
 
  */
@@ -100,6 +180,30 @@ void clearList(LinkedList *list);
 
 void deleteList(LinkedList *list);
 
+/*
+
+    void clearListKeepValues(LinkedList *list)
+
+    - Clears all elements in the list, but does NOT free the values.
+    - For lists sharing their values with another list (see unionOfSortedLists).
+    - O(n) Time, O(1) Space
+
+*/
+
+void clearListKeepValues(LinkedList *list);
+
+/*
+
+    void deleteListKeepValues(LinkedList *list)
+
+    - Deletes the list and its nodes, but does NOT free the values.
+    - For lists sharing their values with another list (see unionOfSortedLists).
+    - O(n) Time, O(1) Space
+
+*/
+
+void deleteListKeepValues(LinkedList *list);
+
 
 /*
 
@@ -116,6 +220,21 @@ void deleteList(LinkedList *list);
 void forEachElementInList(LinkedList *list, void(*f)(void*));
 
 
+/*
+
+    void forEachElementInListUpTo(LinkedList *list, int Count, void(*f)(void*))
+
+    - Same as forEachElementInList, but only for the first Count elements.
+    - Never looks past the Count-th node, so it can run while another thread keeps
+      adding to the end of the list, as long as Count elements were already there
+      (and that thread published Count with release semantics).
+    - O(Count) Time, O(1) Space
+
+ */
+
+void forEachElementInListUpTo(LinkedList *list, int Count, void(*f)(void*));
+
+
 /*
 
     void BinarySearch(LinkedList *list, void(*Evaluate)(void*),void *Destination, int *Index)
@@ -134,4 +253,278 @@ void forEachElementInList(LinkedList *list, void(*f)(void*));
 void BinarySearch(LinkedList *list,void *Target ,int(*Evaluate)(void* Value, void* Target, unsigned short int* MoveRight),void *Destination, int *Index);
 
 
+/*
+
+    int findValueInList(LinkedList *list, void *Value)
+
+    - Finds the first element that is the same pointer as Value.
+    - Returns its index, or -1 if it's not in the list.
+    - If found, the cursor is moved to it, so getFromList on the returned index is O(1).
+    - When the values are stored as an array (see enableListAdaptiveStorage), compares
+      several pointers at once with SSE2 or AVX2 when the CPU has them.
+    - O(n) Time, O(1) Space
+
+ */
+
+int findValueInList(LinkedList *list, void *Value);
+
+/*
+
+    int findKeyInList(LinkedList *list, size_t KeyOffset, int Key)
+
+    - Finds the first element whose value holds an int equal to Key,
+      KeyOffset bytes into it (use offsetof to get KeyOffset).
+    - All values MUST be non - NULL.
+    - Returns its index, or -1 if it's not in the list.
+    - If found, the cursor is moved to it, so getFromList on the returned index is O(1).
+    - When the values are stored as an array (see enableListAdaptiveStorage), compares
+      several keys at once with SSE2 or AVX2 when the CPU has them.
+    - O(n) Time, O(1) Space
+
+ */
+
+int findKeyInList(LinkedList *list, size_t KeyOffset, int Key);
+
+/*
+
+    void mergeSortedLists(LinkedList *list, LinkedList *other, int(*Compare)(void *A, void *B))
+
+    - Merges two sorted lists into list. The nodes of other are relinked into list,
+      nothing is allocated, and other is left empty.
+    - Compare MUST RETURN A NEGATIVE VALUE IF A COMES BEFORE B, ZERO IF THEY ARE EQUAL,
+      AND A POSITIVE VALUE IF A COMES AFTER B (Same as qsort).
+    - Equal values keep their order, values from list come first.
+    - O(n + m) Time, O(1) Space
+
+ */
+
+void mergeSortedLists(LinkedList *list, LinkedList *other, int(*Compare)(void *A, void *B));
+
+/*
+
+    void concatenateLists(LinkedList *list, LinkedList *other)
+
+    - Moves all the nodes of other to the end of list. Nothing is allocated,
+      and other is left empty.
+    - O(1) Time, O(1) Space
+
+ */
+
+void concatenateLists(LinkedList *list, LinkedList *other);
+
+/*
+
+    LinkedList *unionOfSortedLists(LinkedList *list, LinkedList *other, int(*Compare)(void *A, void *B), int ReuseNodes)
+
+    - Returns a new sorted list with the values found in list or other (equal values are taken once, from list).
+    - Compare works the same way as in mergeSortedLists.
+    - If ReuseNodes is ZERO, the lists are left untouched, and a node is allocated for each value.
+      THE NEW LIST SHARES ITS VALUES WITH list AND other, the values are not copied.
+      Tear it down with clearListKeepValues or deleteListKeepValues, deleteList would free
+      values that list and other still hold, and they would be freed twice.
+    - If ReuseNodes is NON - ZERO, the nodes are moved out of list and other into the new list,
+      nothing is allocated, and list and other keep only the values that were left out.
+    - Both lists are walked once, O(n + m) Time
+
+ */
+
+LinkedList *unionOfSortedLists(LinkedList *list, LinkedList *other, int(*Compare)(void *A, void *B), int ReuseNodes);
+
+/*
+
+    LinkedList *intersectionOfSortedLists(LinkedList *list, LinkedList *other, int(*Compare)(void *A, void *B), int ReuseNodes)
+
+    - Returns a new sorted list with the values of list that are also found in other.
+    - ReuseNodes works the same way as in unionOfSortedLists.
+    - Both lists are walked once, O(n + m) Time
+
+ */
+
+LinkedList *intersectionOfSortedLists(LinkedList *list, LinkedList *other, int(*Compare)(void *A, void *B), int ReuseNodes);
+
+/*
+
+    LinkedList *differenceOfSortedLists(LinkedList *list, LinkedList *other, int(*Compare)(void *A, void *B), int ReuseNodes)
+
+    - Returns a new sorted list with the values of list that are NOT found in other.
+    - ReuseNodes works the same way as in unionOfSortedLists.
+    - Both lists are walked once, O(n + m) Time
+
+ */
+
+LinkedList *differenceOfSortedLists(LinkedList *list, LinkedList *other, int(*Compare)(void *A, void *B), int ReuseNodes);
+
+
+/*
+
+    Memory Usage
+
+ */
+
+// How much memory a list (or all the lists) holds, in bytes
+typedef struct ListMemoryReport {
+
+    // Number of lists counted
+    size_t ListCount;
+
+    // Number of nodes
+    size_t NodeCount;
+
+    // The LinkedList structures themselves
+    size_t ListBytes;
+
+    // The nodes
+    size_t NodeBytes;
+
+    // The array of values, for lists stored as an array by Adaptive Storage
+    size_t ArrayBytes;
+
+    // Index and cache structures allocated next to the nodes
+    size_t IndexBytes;
+
+    // Estimated bytes lost to malloc's headers and rounding, for all of the above
+    size_t AllocatorOverheadBytes;
+
+    // The values, as reported by the SizeOfValue callback (0 without one)
+    size_t ValueBytes;
+
+    // Everything above added up
+    size_t TotalBytes;
+
+} ListMemoryReport;
+
+/*
+
+    void getListMemoryUsage(LinkedList *list, ListMemoryReport *Report, size_t(*SizeOfValue)(void *Value))
+
+    - Fills Report with the memory held by the list.
+    - SizeOfValue is called on every value to count the memory behind it, pass NULL to skip it.
+    - O(1) Time without SizeOfValue, O(n) Time with it, O(1) Space
+
+ */
+
+void getListMemoryUsage(LinkedList *list, ListMemoryReport *Report, size_t(*SizeOfValue)(void *Value));
+
+/*
+
+    void getAllListsMemoryUsage(ListMemoryReport *Report, size_t(*SizeOfValue)(void *Value))
+
+    - Fills Report with the memory held by every list that is currently alive
+      (created with newList, and not deleted yet).
+    - Only the registry is locked, not the lists. Reading a list while another thread changes it
+      is a data race (undefined behaviour, not just approximate numbers), so no list may be
+      changed while this runs, unless its owner holds a lock of its own that you hold too.
+    - Every newList and deleteList takes a process wide mutex to keep the registry.
+      Compile LinkedList.c with -DLINKEDLIST_NO_REGISTRY to leave the registry out (and with it
+      the need for POSIX threads); then no list is registered, and this reports nothing.
+    - O(number of lists) Time without SizeOfValue, O(number of values) with it
+
+ */
+
+void getAllListsMemoryUsage(ListMemoryReport *Report, size_t(*SizeOfValue)(void *Value));
+
+/*
+
+    int getLiveListCount()
+
+    - Returns the number of lists that are currently alive (0 with LINKEDLIST_NO_REGISTRY).
+
+ */
+
+int getLiveListCount();
+
+/*
+
+    void forEachLiveList(void(*f)(LinkedList *list, void *UserData), void *UserData)
+
+    - Apply the function f to every list that is currently alive, for example to
+      find the biggest ones with getListMemoryUsage.
+    - f MUST NOT create or delete lists, and the same data race rules as
+      getAllListsMemoryUsage apply to reading them.
+
+ */
+
+void forEachLiveList(void(*f)(LinkedList *list, void *UserData), void *UserData);
+
+
+/*
+
+    Tracing
+
+    Compile with LINKEDLIST_TRACING defined to measure how long addToList, getFromList,
+    addToListAtIndex, removeFromListAtIndex and BinarySearch take. Without it, none of
+    this exists, and the list costs nothing extra.
+
+    Every list keeps a histogram per operation, with one bucket per power of two
+    nanoseconds, and you can register your own hooks that run before and after
+    every operation.
+
+ */
+
+#ifdef LINKEDLIST_TRACING
+
+#include <stdio.h>
+
+// Operations that are traced
+typedef enum ListOperation {
+    LIST_ADD,
+    LIST_GET,
+    LIST_ADD_AT_INDEX,
+    LIST_REMOVE_AT_INDEX,
+    LIST_BINARY_SEARCH,
+    LIST_OPERATION_COUNT
+} ListOperation;
+
+// Hook called before or after an operation
+typedef void (*ListTraceHook)(LinkedList *list, ListOperation Operation, void *UserData);
+
+/*
+
+    void setListTraceHooks(LinkedList *list, ListTraceHook Begin, ListTraceHook End, void *UserData)
+
+    - Begin is called before, and End after, every traced operation on the list.
+      UserData is passed on to both. Either may be NULL.
+    - The hooks are not counted in the histograms.
+
+ */
+
+void setListTraceHooks(LinkedList *list, ListTraceHook Begin, ListTraceHook End, void *UserData);
+
+/*
+
+    long long getListLatencyPercentile(LinkedList *list, ListOperation Operation, double Percentile)
+
+    - Returns the latency in nanoseconds that Percentile percent (0 to 100) of the
+      calls to Operation stayed under. Since the buckets are powers of two,
+      it's an upper bound, at most twice the real value.
+    - Returns 0 if Operation was never called.
+
+ */
+
+long long getListLatencyPercentile(LinkedList *list, ListOperation Operation, double Percentile);
+
+/*
+
+    void dumpListLatency(LinkedList *list, FILE *Stream, int AsJson)
+
+    - Writes count, mean, min, p50, p90, p99 and max of every operation to Stream,
+      as a table, or as JSON (including the buckets) if AsJson is non - zero.
+
+ */
+
+void dumpListLatency(LinkedList *list, FILE *Stream, int AsJson);
+
+/*
+
+    void resetListLatency(LinkedList *list)
+
+    - Empties all the histograms of the list.
+
+ */
+
+void resetListLatency(LinkedList *list);
+
+#endif
+
+
 #endif
@@ -0,0 +1,255 @@
+/*
+    Sharded List
+
+    When many threads append to one list, they all fight over its tail,
+    even if the list was lock free. So we don't give them one list.
+
+    A Sharded List keeps one LinkedList per shard. Each thread is given a
+    shard the first time it appends to the list, and keeps appending to it.
+    Every list hands out its own shards, one after the other, so with at
+    least as many shards as threads appending to it, nobody shares a tail,
+    and appending scales with the number of threads.
+
+    Every list has its own thread specific key (pthread_key_t), holding the slot
+    it gave the calling thread, so a thread keeps its slot for as long as the list
+    lives, no matter how many other lists it appends to in between.
+    A shard isn't given back when its thread exits, so a list that sees more
+    threads over its lifetime than it has shards ends up with shared shards.
+
+    Each shard still has a lock, for the rare case of two threads sharing a shard,
+    and for collectShardedList. An uncontended lock is cheap, and since every shard
+    sits on its own cache line, threads don't slow each other down.
+
+    After every append, the shard "publishes" its size with a release store.
+    Readers load it with acquire, and then only walk that many nodes, so they
+    only ever see nodes that were completely linked in, without locking the writers.
+
+    The global view is made by concatenating the shards' chains of nodes,
+    which costs O(1) per shard, no matter how many values they hold.
+
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "ShardedList.h"
+
+// Size of a cache line, to keep shards from sharing one
+#define CACHE_LINE 64
+
+/*
+
+    Shard
+
+    One LinkedList, its lock, and its published size.
+
+ */
+
+typedef struct Shard {
+
+    // Guards List
+    _Alignas(CACHE_LINE) pthread_mutex_t Lock;
+
+    // The values appended to this shard
+    LinkedList *List;
+
+    // Size of List, stored after every append
+    atomic_int Published;
+
+} Shard;
+
+/*
+
+    Sharded List
+
+ */
+
+struct ShardedList {
+
+    // Number of shards
+    int ShardCount;
+
+    // The shards
+    Shard *Shards;
+
+    // The shard this list gave the calling thread, plus one (NULL until it appends)
+    pthread_key_t ThreadSlot;
+
+    // Next slot to give out to a thread
+    atomic_int NextThreadSlot;
+
+};
+
+/*
+
+  ShardedList *newShardedList(int ShardCount)
+
+  This function initializes a new ShardedList in heap memory,
+  with ShardCount empty shards, and returns the reference to it.
+
+*/
+
+ShardedList *newShardedList(int ShardCount) {
+
+    if (ShardCount <= 0) {
+        printf("INVALID SHARD COUNT EXCEPTION. ATTEMPT TO CREATE LIST WITH %i SHARDS\n", ShardCount);
+        exit(-1);
+    }
+
+    ShardedList *list = (ShardedList *) malloc(sizeof(struct ShardedList));
+
+    // There are only PTHREAD_KEYS_MAX keys per process
+    if (pthread_key_create(&list->ThreadSlot, NULL) != 0) {
+        printf("OUT OF THREAD KEYS EXCEPTION. TOO MANY SHARDED LISTS AT ONCE\n");
+        exit(-1);
+    }
+
+    list->ShardCount = ShardCount;
+    atomic_init(&list->NextThreadSlot, 0);
+    list->Shards = (Shard *) aligned_alloc(CACHE_LINE, sizeof(struct Shard) * ShardCount);
+
+    for (int i = 0; i < ShardCount; ++i) {
+        pthread_mutex_init(&list->Shards[i].Lock, NULL);
+        list->Shards[i].List = newList();
+        atomic_init(&list->Shards[i].Published, 0);
+    }
+
+    return list;
+}
+
+/*
+
+    static Shard *getThreadShard(ShardedList *list)
+
+    Returns the calling thread's shard. The list gives out slots one after
+    the other, so the first ShardCount threads all get their own shard.
+    A thread is given a slot once per list, and keeps it.
+
+ */
+
+static Shard *getThreadShard(ShardedList *list) {
+
+    intptr_t Slot = (intptr_t) pthread_getspecific(list->ThreadSlot);
+
+    if (Slot == 0) {
+        int Given = atomic_fetch_add_explicit(&list->NextThreadSlot, 1, memory_order_relaxed) & 0x7fffffff;
+        Slot = Given % list->ShardCount + 1;
+        pthread_setspecific(list->ThreadSlot, (void *) Slot);
+    }
+
+    return &list->Shards[Slot - 1];
+}
+
+/*
+
+    int getShardedListSize(ShardedList *list)
+    - Returns the size of all the shards together
+
+ */
+
+int getShardedListSize(ShardedList *list) {
+
+    int Size = 0;
+
+    for (int i = 0; i < list->ShardCount; ++i)
+        Size += atomic_load_explicit(&list->Shards[i].Published, memory_order_acquire);
+
+    return Size;
+}
+
+/*
+
+    void addToShardedList(ShardedList *list, void *Value)
+
+    Appends the value to the calling thread's shard, and publishes the new size.
+
+ */
+
+void addToShardedList(ShardedList *list, void *Value) {
+
+    Shard *shard = getThreadShard(list);
+
+    pthread_mutex_lock(&shard->Lock);
+
+    addToList(shard->List, Value);
+
+    // The node is completely linked in, let the readers see it
+    atomic_store_explicit(&shard->Published, getListSize(shard->List), memory_order_release);
+
+    pthread_mutex_unlock(&shard->Lock);
+}
+
+/*
+
+    void forEachElementInShardedList(ShardedList *list, void(*f)(void*))
+
+    Apply the function f to the published values of every shard.
+
+ */
+
+void forEachElementInShardedList(ShardedList *list, void(*f)(void *)) {
+
+    for (int i = 0; i < list->ShardCount; ++i) {
+
+        Shard *shard = &list->Shards[i];
+
+        int Published = atomic_load_explicit(&shard->Published, memory_order_acquire);
+
+        // Only walk what was published, the writer may be linking the next node right now
+        forEachElementInListUpTo(shard->List, Published, f);
+    }
+
+}
+
+/*
+
+    LinkedList *collectShardedList(ShardedList *list)
+
+    Moves the nodes of every shard into a new list.
+
+ */
+
+LinkedList *collectShardedList(ShardedList *list) {
+
+    LinkedList *Collected = newList();
+
+    for (int i = 0; i < list->ShardCount; ++i) {
+
+        Shard *shard = &list->Shards[i];
+
+        pthread_mutex_lock(&shard->Lock);
+
+        concatenateLists(Collected, shard->List);
+
+        atomic_store_explicit(&shard->Published, 0, memory_order_release);
+
+        pthread_mutex_unlock(&shard->Lock);
+    }
+
+    return Collected;
+}
+
+/*
+
+    void deleteShardedList(ShardedList *list)
+
+    Completely clears all the values in all the shards,
+    and deletes the list.
+
+ */
+
+void deleteShardedList(ShardedList *list) {
+
+    for (int i = 0; i < list->ShardCount; ++i) {
+        deleteList(list->Shards[i].List);
+        pthread_mutex_destroy(&list->Shards[i].Lock);
+    }
+
+    pthread_key_delete(list->ThreadSlot);
+
+    free(list->Shards);
+    free(list);
+}
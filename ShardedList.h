@@ -0,0 +1,107 @@
+#ifndef SHARDEDLIST_H
+#define SHARDEDLIST_H
+
+#include "LinkedList.h"
+
+/*
+
+    Sharded List
+
+    A list for many threads appending at once (logging from many cores, for example).
+
+    - The list is split into shards, each one a LinkedList, and every thread
+      appends to its own shard, so threads don't fight over a tail.
+    - Shards are given out per list, in the order threads first append to it,
+      and aren't given back when a thread exits. Once more threads have appended
+      to a list than it has shards, threads share shards (still safe, just slower).
+    - A thread keeps its shard of a list for the list's whole life, however many
+      other lists it appends to. Each list uses one pthread_key_t for that, so at most
+      PTHREAD_KEYS_MAX (at least 128, 1024 on glibc) sharded lists can exist at once.
+    - The size and forEach read all the shards without locking the writers.
+    - collectShardedList hands out everything appended so far as one LinkedList.
+    - Values from one thread stay in order, values from different threads don't
+      have an order between them.
+
+ */
+
+// Sharded List Data Type
+typedef struct ShardedList ShardedList;
+
+/*
+
+    ShardedList *newShardedList(int ShardCount)
+
+    - To construct the sharded list, with ShardCount shards.
+      Use at least as many shards as there are threads appending to it.
+    - Returns reference to the newly
+      created list.
+
+ */
+
+ShardedList *newShardedList(int ShardCount);
+
+/*
+
+    int getShardedListSize(ShardedList *list)
+
+    - Returns the number of values in all the shards.
+    - Doesn't lock the writers, values being appended right now may or may not be counted.
+    - O(Shards) Time, O(1) Space
+
+ */
+
+int getShardedListSize(ShardedList *list);
+
+/*
+
+    void addToShardedList(ShardedList *list, void *Value)
+
+    - Adds a new value to the calling thread's shard.
+    - Safe to call from any number of threads at once.
+    - O(1) Time, O(1) Space
+
+ */
+
+void addToShardedList(ShardedList *list, void *Value);
+
+/*
+
+    void forEachElementInShardedList(ShardedList *list, void(*f)(void*))
+
+    - Apply the function f to the values of every shard, one shard after the other.
+    - Doesn't lock the writers, values being appended right now may or may not be visited.
+    - MUST NOT run at the same time as collectShardedList or deleteShardedList.
+    - O(n) Time, O(1) Space
+
+ */
+
+void forEachElementInShardedList(ShardedList *list, void(*f)(void *));
+
+/*
+
+    LinkedList *collectShardedList(ShardedList *list)
+
+    - Moves all the values of all the shards into a new LinkedList, shard after shard,
+      and returns it. The shards are left empty.
+    - Writers are only held up while their own shard is moved.
+    - O(Shards) Time, O(1) Space
+
+ */
+
+LinkedList *collectShardedList(ShardedList *list);
+
+/*
+
+    void deleteShardedList(ShardedList *list)
+
+    - Completely clears all the values in all the shards,
+      and deletes the list.
+    - No thread may be using the list anymore.
+    - O(n) Time, O(1) Space
+
+ */
+
+void deleteShardedList(ShardedList *list);
+
+
+#endif
@@ -0,0 +1,472 @@
+/*
+    Adaptive Storage Benchmark
+
+    Runs the same operations on three lists:
+     -  a plain array of pointers (realloc and memmove), the best an array can do,
+     -  a LinkedList, always nodes,
+     -  a LinkedList with Adaptive Storage on,
+    for three workloads:
+     -  read heavy: getFromList at random indices, and now and then an insert or remove.
+     -  middle insert heavy: inserts and removes around a position drifting through
+        the middle of the list (an editor's buffer), and a few reads near it.
+     -  phases: read heavy and middle insert heavy, taking turns.
+
+    Adaptive Storage should end up close to the better of the other two in every workload.
+
+    Before that, it measures what the costs Adaptive Storage weighs with take on this
+    machine, and prints them in values moved by memmove, to compare with the ADAPTIVE_*
+    defaults in LinkedList.c:
+     -  moving one value, with memmove, in the middle of a plain array,
+     -  a hop, walking the nodes with forEachElementInList,
+     -  adding and removing a value in the middle of the nodes, at the cursor (malloc and free),
+     -  moving one value between array and nodes, when Adaptive Storage switches.
+    Every time is the best of RUNS runs.
+
+    Build (from the repository root):
+        gcc -O2 -pthread -I. bench/AdaptiveStorageBench.c LinkedList.c -o AdaptiveStorageBench
+
+    The costs Adaptive Storage weighs with can be changed for a build, to try other values:
+        gcc -O2 -pthread -I. -DADAPTIVE_HOP_COST=4 bench/AdaptiveStorageBench.c LinkedList.c -o AdaptiveStorageBench
+
+    Run:
+        ./AdaptiveStorageBench [Size] [Operations]
+
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "LinkedList.h"
+
+// Operations per phase, in the phases workload
+#define PHASE_LENGTH 20000
+
+// Every time is the fastest of this many runs
+#define RUNS 3
+
+static int Size = 10000;
+static int Operations = 400000;
+
+// What the next operation does
+enum Operation {
+    GET, INSERT, REMOVE
+};
+
+enum Workload {
+    READ_HEAVY, INSERT_HEAVY, PHASES
+};
+
+static const char *WorkloadNames[] = {"read heavy", "middle insert heavy", "phases"};
+
+/*
+
+    Plain array of pointers
+
+ */
+
+typedef struct PlainArray {
+
+    void **Values;
+
+    int Size;
+
+    int Capacity;
+
+} PlainArray;
+
+static void insertIntoPlainArray(PlainArray *array, void *Value, int Index) {
+
+    if (array->Size == array->Capacity) {
+        array->Capacity = array->Capacity * 2 + 8;
+        array->Values = (void **) realloc(array->Values, sizeof(void *) * array->Capacity);
+    }
+
+    memmove(array->Values + Index + 1, array->Values + Index, sizeof(void *) * (array->Size - Index));
+
+    array->Values[Index] = Value;
+    array->Size++;
+}
+
+static void removeFromPlainArray(PlainArray *array, int Index) {
+
+    memmove(array->Values + Index, array->Values + Index + 1, sizeof(void *) * (array->Size - Index - 1));
+
+    array->Size--;
+}
+
+/*
+
+    Operations
+
+    Every list gets exactly the same operations, from the same seed.
+
+ */
+
+static unsigned long long Seed;
+
+static unsigned int nextRandom() {
+
+    // xorshift64
+    Seed ^= Seed << 13;
+    Seed ^= Seed >> 7;
+    Seed ^= Seed << 17;
+
+    return (unsigned int) (Seed >> 32);
+}
+
+// Where the middle insert heavy workload is editing
+static int EditPosition;
+
+// Inserts and removes take turns, so the list stays at Size values
+static enum Operation insertOrRemove(int Count) {
+    return Count <= Size ? INSERT : REMOVE;
+}
+
+/*
+
+    static enum Operation nextOperation(enum Workload Workload, int Step, int Count, int *Index)
+
+    Picks the next operation, and its index, for a list of Count values.
+
+ */
+
+static enum Operation nextOperation(enum Workload Workload, int Step, int Count, int *Index) {
+
+    if (Workload == PHASES)
+        Workload = (Step / PHASE_LENGTH) % 2 == 0 ? READ_HEAVY : INSERT_HEAVY;
+
+    unsigned int Dice = nextRandom() % 100;
+
+    if (Workload == READ_HEAVY) {
+
+        *Index = (int) (nextRandom() % (unsigned) Count);
+
+        // 99% reads
+        if (Dice < 99)
+            return GET;
+
+        return insertOrRemove(Count);
+    }
+
+    // Drift a few places, and stay in the middle half of the list
+    EditPosition += (int) (nextRandom() % 9) - 4;
+
+    if (EditPosition < Count / 4)
+        EditPosition = Count / 4;
+
+    if (EditPosition > Count * 3 / 4)
+        EditPosition = Count * 3 / 4;
+
+    *Index = EditPosition;
+
+    // 10% reads, the rest inserts and removes
+    if (Dice < 10)
+        return GET;
+
+    return insertOrRemove(Count);
+}
+
+static double nowSeconds() {
+
+    struct timespec Now;
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+
+    return Now.tv_sec + Now.tv_nsec / 1e9;
+}
+
+// Keeps the reads from being optimized away
+static unsigned long long Checksum;
+
+/*
+
+    static double runPlainArray(enum Workload Workload)
+    static double runList(enum Workload Workload, int Adaptive, int *Switches, int *EndsAsArray)
+
+    Run the workload, and return how long it took in seconds.
+
+ */
+
+static double runPlainArray(enum Workload Workload) {
+
+    PlainArray array = {NULL, 0, 0};
+
+    for (int i = 0; i < Size; ++i)
+        insertIntoPlainArray(&array, (void *) (long) (i + 1), i);
+
+    Seed = 88172645463325252ULL;
+    EditPosition = Size / 2;
+
+    double Start = nowSeconds();
+
+    for (int Step = 0; Step < Operations; ++Step) {
+
+        int Index;
+
+        switch (nextOperation(Workload, Step, array.Size, &Index)) {
+            case GET:
+                Checksum += (unsigned long long) array.Values[Index];
+                break;
+            case INSERT:
+                insertIntoPlainArray(&array, (void *) (long) (Step + 1), Index);
+                break;
+            default:
+                removeFromPlainArray(&array, Index);
+        }
+    }
+
+    double Elapsed = nowSeconds() - Start;
+
+    free(array.Values);
+
+    return Elapsed;
+}
+
+static double runList(enum Workload Workload, int Adaptive, int *Switches, int *EndsAsArray) {
+
+    LinkedList *list = newList();
+
+    for (int i = 0; i < Size; ++i)
+        addToList(list, (void *) (long) (i + 1));
+
+    if (Adaptive)
+        enableListAdaptiveStorage(list);
+
+    Seed = 88172645463325252ULL;
+    EditPosition = Size / 2;
+
+    *Switches = 0;
+    int WasArray = isListStoredAsArray(list);
+
+    double Start = nowSeconds();
+
+    for (int Step = 0; Step < Operations; ++Step) {
+
+        int Index;
+
+        switch (nextOperation(Workload, Step, getListSize(list), &Index)) {
+            case GET:
+                Checksum += (unsigned long long) getFromList(list, Index);
+                break;
+            case INSERT:
+                addToListAtIndex(list, (void *) (long) (Step + 1), Index);
+                break;
+            default:
+                removeFromListAtIndex(list, Index);
+        }
+
+        if (isListStoredAsArray(list) != WasArray) {
+            WasArray = !WasArray;
+            (*Switches)++;
+        }
+    }
+
+    double Elapsed = nowSeconds() - Start;
+
+    *EndsAsArray = WasArray;
+
+    // The values are just numbers, nothing to free
+    deleteListKeepValues(list);
+
+    return Elapsed;
+}
+
+/*
+
+    Costs
+
+    Each returns nanoseconds per value moved, per hop, per add and remove, and per value migrated.
+
+ */
+
+static double measureMemmove() {
+
+    PlainArray array = {NULL, 0, 0};
+
+    for (int i = 0; i < Size; ++i)
+        insertIntoPlainArray(&array, (void *) (long) (i + 1), i);
+
+    double Start = nowSeconds();
+
+    for (int Step = 0; Step < Operations; ++Step) {
+        insertIntoPlainArray(&array, NULL, Size / 2);
+        removeFromPlainArray(&array, Size / 2);
+    }
+
+    double Elapsed = nowSeconds() - Start;
+
+    free(array.Values);
+
+    // Both move the back half of the array
+    return Elapsed * 1e9 / (2.0 * Operations * (Size - Size / 2));
+}
+
+static void addUp(void *Value) {
+    Checksum += (unsigned long long) Value;
+}
+
+static double measureHop() {
+
+    LinkedList *list = newList();
+
+    for (int i = 0; i < Size; ++i)
+        addToList(list, (void *) (long) (i + 1));
+
+    int Walks = Operations / Size + 1;
+
+    double Start = nowSeconds();
+
+    for (int i = 0; i < Walks; ++i)
+        forEachElementInList(list, addUp);
+
+    double Elapsed = nowSeconds() - Start;
+
+    deleteListKeepValues(list);
+
+    return Elapsed * 1e9 / ((double) Walks * Size);
+}
+
+static double measureNode() {
+
+    LinkedList *list = newList();
+
+    for (int i = 0; i < Size; ++i)
+        addToList(list, (void *) (long) (i + 1));
+
+    double Start = nowSeconds();
+
+    // In the middle, next to the cursor, so there's next to nothing to walk
+    for (int Step = 0; Step < Operations; ++Step) {
+        addToListAtIndex(list, (void *) (long) (Step + 1), Size / 2);
+        removeFromListAtIndex(list, Size / 2);
+    }
+
+    double Elapsed = nowSeconds() - Start;
+
+    deleteListKeepValues(list);
+
+    // One malloc and one free per step
+    return Elapsed * 1e9 / (2.0 * Operations);
+}
+
+static double measureMigration() {
+
+    LinkedList *list = newList();
+
+    for (int i = 0; i < Size; ++i)
+        addToList(list, (void *) (long) (i + 1));
+
+    enableListAdaptiveStorage(list);
+
+    // Random reads until it moves into an array, timing only the read that moved it
+    double ToArray = 0;
+    Seed = 88172645463325252ULL;
+
+    for (int Step = 0; Step < 100 * Operations && !isListStoredAsArray(list); ++Step) {
+
+        int Index = (int) (nextRandom() % (unsigned) Size);
+
+        double Start = nowSeconds();
+        Checksum += (unsigned long long) getFromList(list, Index);
+        ToArray = nowSeconds() - Start;
+    }
+
+    // Inserts and removes at the head until it moves back
+    double ToNodes = 0;
+
+    for (int Step = 0; Step < 100 * Operations && isListStoredAsArray(list); ++Step) {
+
+        double Start = nowSeconds();
+
+        if (Step % 2 == 0)
+            addToListAtIndex(list, (void *) (long) (Step + 1), 0);
+        else
+            removeFromListAtIndex(list, 0);
+
+        ToNodes = nowSeconds() - Start;
+    }
+
+    deleteListKeepValues(list);
+
+    return (ToArray + ToNodes) * 1e9 / (2.0 * Size);
+}
+
+static double fastest(double (*Measure)()) {
+
+    double Best = Measure();
+
+    for (int r = 1; r < RUNS; ++r) {
+        double Time = Measure();
+        if (Time < Best)
+            Best = Time;
+    }
+
+    return Best;
+}
+
+static void printCosts() {
+
+    double Memmove = fastest(measureMemmove);
+    double Hop = fastest(measureHop);
+    double Node = fastest(measureNode);
+    double Migration = fastest(measureMigration);
+
+    printf("%-28s %10s %12s\n", "cost", "ns", "in values");
+    printf("%-28s %10.3f %12.0f\n", "memmove, per value", Memmove, 1.0);
+    printf("%-28s %10.3f %12.0f\n", "hop", Hop, Hop / Memmove);
+    printf("%-28s %10.3f %12.0f\n", "node, add or remove", Node, Node / Memmove);
+    printf("%-28s %10.3f %12.0f\n\n", "migration, per value", Migration, Migration / Memmove);
+}
+
+int main(int argc, char **argv) {
+
+    if (argc > 1)
+        Size = atoi(argv[1]);
+
+    if (argc > 2)
+        Operations = atoi(argv[2]);
+
+    printf("%d values, %d operations, best of %d runs\n\n", Size, Operations, RUNS);
+
+    printCosts();
+
+    printf("%-20s %10s %10s %10s %10s %9s %s\n", "", "array (s)", "nodes (s)", "adaptive", "vs best", "switches",
+           "ends as");
+
+    for (int w = READ_HEAVY; w <= PHASES; ++w) {
+
+        int Switches, EndsAsArray;
+
+        double Array = runPlainArray((enum Workload) w);
+        double Nodes = runList((enum Workload) w, 0, &Switches, &EndsAsArray);
+        double Adaptive = runList((enum Workload) w, 1, &Switches, &EndsAsArray);
+
+        // Every run does the same, so only the time changes
+        for (int r = 1; r < RUNS; ++r) {
+
+            double Time = runPlainArray((enum Workload) w);
+            if (Time < Array)
+                Array = Time;
+
+            Time = runList((enum Workload) w, 0, &Switches, &EndsAsArray);
+            if (Time < Nodes)
+                Nodes = Time;
+
+            Time = runList((enum Workload) w, 1, &Switches, &EndsAsArray);
+            if (Time < Adaptive)
+                Adaptive = Time;
+        }
+
+        double Best = Array < Nodes ? Array : Nodes;
+
+        printf("%-20s %10.3f %10.3f %10.3f %9.2fx %9d %s\n", WorkloadNames[w], Array, Nodes, Adaptive,
+               Adaptive / Best, Switches, EndsAsArray ? "array" : "nodes");
+    }
+
+    printf("\n(checksum %llu)\n", Checksum);
+
+    return 0;
+}
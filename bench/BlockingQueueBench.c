@@ -0,0 +1,279 @@
+/*
+    Blocking Queue Benchmark
+
+    Hands Items values from producer threads to consumer threads,
+    1:1, N:1 and N:M, three ways:
+     -  LinkedList, with a mutex and two condition variables of its own,
+        addToList and removeFromListAtIndex(list, 0), what you'd write without the queue.
+     -  BlockingQueue, one value per dequeueFromQueue.
+     -  BlockingQueue, up to BATCH values per dequeueBatchFromQueue.
+
+    Every value is stamped when it's enqueued, and the consumer measures how long it waited,
+    so we get the throughput, and the 50th and 99th percentile of the latency.
+    Every version holds at most CAPACITY values.
+
+    Build (from the repository root):
+        gcc -O2 -pthread -I. bench/BlockingQueueBench.c BlockingQueue.c LinkedList.c -o BlockingQueueBench
+
+    Run:
+        ./BlockingQueueBench [Items]
+
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "BlockingQueue.h"
+#include "LinkedList.h"
+
+// Most values waiting at once
+#define CAPACITY 1024
+
+// Most values taken by one dequeueBatchFromQueue
+#define BATCH 64
+
+// Most threads on either side
+#define MAX_THREADS 8
+
+// One value handed over
+typedef struct Item {
+
+    // When it was enqueued
+    long long EnqueuedAt;
+
+} Item;
+
+// Tells a consumer to stop, enqueued once every producer is done
+static Item Stop;
+
+static int Items = 1000000;
+static Item *AllItems;
+static long long *Latencies;
+
+static int Producers;
+static int Consumers;
+
+// What the consumers use to take values
+enum Mode {
+    LIST, QUEUE, QUEUE_BATCH
+};
+
+static enum Mode RunMode;
+
+static BlockingQueue *queue;
+
+// The LinkedList version
+static LinkedList *list;
+static pthread_mutex_t ListLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t ListNotEmpty = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t ListNotFull = PTHREAD_COND_INITIALIZER;
+
+static long long nowNanos() {
+
+    struct timespec Now;
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+
+    return Now.tv_sec * 1000000000LL + Now.tv_nsec;
+}
+
+/*
+
+    LinkedList with a mutex and condition variables
+
+ */
+
+static void enqueueToList(void *Value) {
+
+    pthread_mutex_lock(&ListLock);
+
+    while (getListSize(list) == CAPACITY)
+        pthread_cond_wait(&ListNotFull, &ListLock);
+
+    addToList(list, Value);
+
+    pthread_cond_signal(&ListNotEmpty);
+    pthread_mutex_unlock(&ListLock);
+}
+
+static void *dequeueFromList() {
+
+    pthread_mutex_lock(&ListLock);
+
+    while (getListSize(list) == 0)
+        pthread_cond_wait(&ListNotEmpty, &ListLock);
+
+    void *Value = getFromList(list, 0);
+    removeFromListAtIndex(list, 0);
+
+    pthread_cond_signal(&ListNotFull);
+    pthread_mutex_unlock(&ListLock);
+
+    return Value;
+}
+
+static void enqueue(void *Value) {
+
+    if (RunMode == LIST)
+        enqueueToList(Value);
+    else
+        enqueueToQueue(queue, Value);
+}
+
+/*
+
+    Threads
+
+ */
+
+static void *produce(void *Argument) {
+
+    long Id = (long) Argument;
+
+    // Every producer gets its own share of the items
+    for (int i = (int) Id; i < Items; i += Producers) {
+        AllItems[i].EnqueuedAt = nowNanos();
+        enqueue(&AllItems[i]);
+    }
+
+    return NULL;
+}
+
+// Records the latency of a value, returns zero if it was Stop
+static int consume(Item *item) {
+
+    if (item == &Stop)
+        return 0;
+
+    Latencies[item - AllItems] = nowNanos() - item->EnqueuedAt;
+
+    return 1;
+}
+
+static void *consumeAll(void *Argument) {
+
+    void *Batch[BATCH];
+
+    (void) Argument;
+
+    if (RunMode == LIST) {
+        while (consume((Item *) dequeueFromList()));
+        return NULL;
+    }
+
+    if (RunMode == QUEUE) {
+        while (consume((Item *) dequeueFromQueue(queue)));
+        return NULL;
+    }
+
+    for (;;) {
+
+        int Count = dequeueBatchFromQueue(queue, Batch, BATCH);
+        int Stopped = 0;
+
+        for (int i = 0; i < Count; ++i) {
+
+            // Stops are only enqueued after every item, we keep one,
+            // and hand the others back for the other consumers
+            if (!consume((Item *) Batch[i])) {
+                if (Stopped)
+                    enqueueToQueue(queue, &Stop);
+                Stopped = 1;
+            }
+        }
+
+        if (Stopped)
+            return NULL;
+    }
+}
+
+static int compareLatencies(const void *A, const void *B) {
+
+    long long a = *(const long long *) A;
+    long long b = *(const long long *) B;
+
+    return (a > b) - (a < b);
+}
+
+/*
+
+    static void run(enum Mode Mode, const char *Name)
+
+    Runs Producers producers and Consumers consumers, and prints the results.
+
+ */
+
+static void run(enum Mode Mode, const char *Name) {
+
+    pthread_t ProducerThreads[MAX_THREADS];
+    pthread_t ConsumerThreads[MAX_THREADS];
+
+    RunMode = Mode;
+
+    long long Start = nowNanos();
+
+    for (long i = 0; i < Consumers; ++i)
+        pthread_create(&ConsumerThreads[i], NULL, consumeAll, NULL);
+
+    for (long i = 0; i < Producers; ++i)
+        pthread_create(&ProducerThreads[i], NULL, produce, (void *) i);
+
+    for (int i = 0; i < Producers; ++i)
+        pthread_join(ProducerThreads[i], NULL);
+
+    for (int i = 0; i < Consumers; ++i)
+        enqueue(&Stop);
+
+    for (int i = 0; i < Consumers; ++i)
+        pthread_join(ConsumerThreads[i], NULL);
+
+    double Seconds = (nowNanos() - Start) / 1e9;
+
+    qsort(Latencies, Items, sizeof(long long), compareLatencies);
+
+    printf("%5d:%-3d %-14s %12.2f %12.1f %12.1f\n", Producers, Consumers, Name, Items / Seconds / 1e6,
+           Latencies[Items / 2] / 1e3, Latencies[(int) (Items * 0.99)] / 1e3);
+}
+
+int main(int argc, char **argv) {
+
+    if (argc > 1)
+        Items = atoi(argv[1]);
+
+    AllItems = (Item *) malloc(sizeof(struct Item) * Items);
+    Latencies = (long long *) malloc(sizeof(long long) * Items);
+
+    queue = newBlockingQueue(CAPACITY);
+    list = newList();
+
+    // 1:1, N:1, and N:M
+    int Setups[][2] = {{1, 1},
+                       {4, 1},
+                       {4, 4},
+                       {8, 8}};
+
+    printf("%d items, capacity %d\n\n", Items, CAPACITY);
+    printf("%9s %-14s %12s %12s %12s\n", "P:C", "", "M items/s", "p50 (us)", "p99 (us)");
+
+    for (int s = 0; s < 4; ++s) {
+
+        Producers = Setups[s][0];
+        Consumers = Setups[s][1];
+
+        run(LIST, "LinkedList");
+        run(QUEUE, "queue");
+        run(QUEUE_BATCH, "queue batch");
+    }
+
+    // Both are empty by now, so they free no values
+    deleteQueue(queue);
+    deleteList(list);
+
+    free(AllItems);
+    free(Latencies);
+
+    return 0;
+}
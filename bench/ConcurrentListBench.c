@@ -0,0 +1,255 @@
+/*
+    Concurrent List Benchmark
+
+    A table of Size values, read by 1 to 64 threads, while one writer
+    replaces a value every WRITE_EVERY_MICROS microseconds (a routing table).
+
+    Every read is a lookup at a random index. It's measured twice:
+     -  ConcurrentList, every thread with its own reader, no locks.
+     -  LinkedList behind one mutex, what you have to do without it,
+        since getFromList moves the shared cursor.
+
+    Build (from the repository root):
+        gcc -O2 -pthread -I. bench/ConcurrentListBench.c ConcurrentList.c LinkedList.c -o ConcurrentListBench
+
+    Run:
+        ./ConcurrentListBench [Size] [Seconds per run]
+
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "ConcurrentList.h"
+#include "LinkedList.h"
+
+// How often the writer replaces a value
+#define WRITE_EVERY_MICROS 100
+
+// Largest number of reader threads
+#define MAX_READERS 64
+
+static int Size = 1024;
+static double Seconds = 1.0;
+
+static ConcurrentList *Concurrent;
+static LinkedList *Locked;
+static pthread_mutex_t LockedLock = PTHREAD_MUTEX_INITIALIZER;
+
+// The values in Concurrent, by index, so the writer can free the ones it replaces
+static void **Values;
+
+// Set once the run is over
+static atomic_int Stop;
+
+// Lookups done by each reader
+static long long Lookups[MAX_READERS];
+
+static double nowSeconds() {
+
+    struct timespec Now;
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+
+    return Now.tv_sec + Now.tv_nsec / 1e9;
+}
+
+static void *newValue(int Value) {
+
+    int *value = (int *) malloc(sizeof(int));
+    *value = Value;
+
+    return value;
+}
+
+static void sleepMicros(long Micros) {
+
+    struct timespec Pause = {Micros / 1000000L, (Micros % 1000000L) * 1000L};
+    nanosleep(&Pause, NULL);
+}
+
+/*
+
+    Readers
+
+ */
+
+static void *readConcurrent(void *Argument) {
+
+    long Id = (long) Argument;
+    unsigned int Seed = (unsigned int) Id + 1;
+    long long Count = 0;
+
+    ConcurrentListReader *reader = newConcurrentListReader(Concurrent);
+
+    while (!atomic_load_explicit(&Stop, memory_order_relaxed)) {
+
+        beginConcurrentListRead(reader);
+        void *Value = getFromConcurrentList(reader, rand_r(&Seed) % Size);
+        endConcurrentListRead(reader);
+
+        Count += Value != NULL;
+    }
+
+    deleteConcurrentListReader(reader);
+
+    Lookups[Id] = Count;
+    return NULL;
+}
+
+static void *readLocked(void *Argument) {
+
+    long Id = (long) Argument;
+    unsigned int Seed = (unsigned int) Id + 1;
+    long long Count = 0;
+
+    while (!atomic_load_explicit(&Stop, memory_order_relaxed)) {
+
+        pthread_mutex_lock(&LockedLock);
+        void *Value = getFromList(Locked, rand_r(&Seed) % Size);
+        pthread_mutex_unlock(&LockedLock);
+
+        Count += Value != NULL;
+    }
+
+    Lookups[Id] = Count;
+    return NULL;
+}
+
+/*
+
+    Writers
+
+ */
+
+static void *writeConcurrent(void *Argument) {
+
+    unsigned int Seed = 12345;
+
+    (void) Argument;
+
+    while (!atomic_load_explicit(&Stop, memory_order_relaxed)) {
+
+        // Not the last index, so the new value can go back where the old one was
+        int Index = rand_r(&Seed) % (Size - 1);
+
+        void *Removed = Values[Index];
+
+        removeFromConcurrentListAtIndex(Concurrent, Index);
+        addToConcurrentListAtIndex(Concurrent, Values[Index] = newValue(Index), Index);
+
+        // Readers never look inside the values, so the old one can go right away
+        free(Removed);
+        reclaimConcurrentList(Concurrent);
+
+        sleepMicros(WRITE_EVERY_MICROS);
+    }
+
+    return NULL;
+}
+
+static void *writeLocked(void *Argument) {
+
+    unsigned int Seed = 12345;
+
+    (void) Argument;
+
+    while (!atomic_load_explicit(&Stop, memory_order_relaxed)) {
+
+        int Index = rand_r(&Seed) % (Size - 1);
+
+        pthread_mutex_lock(&LockedLock);
+
+        free(getFromList(Locked, Index));
+        removeFromListAtIndex(Locked, Index);
+        addToListAtIndex(Locked, newValue(Index), Index);
+
+        pthread_mutex_unlock(&LockedLock);
+
+        sleepMicros(WRITE_EVERY_MICROS);
+    }
+
+    return NULL;
+}
+
+/*
+
+    static double run(int Readers, void *(*Reader)(void *), void *(*Writer)(void *))
+
+    Runs Readers readers and one writer for Seconds, returns the lookups per second.
+
+ */
+
+static double run(int Readers, void *(*Reader)(void *), void *(*Writer)(void *)) {
+
+    pthread_t Threads[MAX_READERS];
+    pthread_t WriterThread;
+
+    atomic_store(&Stop, 0);
+
+    pthread_create(&WriterThread, NULL, Writer, NULL);
+
+    for (long i = 0; i < Readers; ++i)
+        pthread_create(&Threads[i], NULL, Reader, (void *) i);
+
+    double Start = nowSeconds();
+    sleepMicros((long) (Seconds * 1e6));
+    atomic_store(&Stop, 1);
+
+    long long Total = 0;
+
+    for (int i = 0; i < Readers; ++i) {
+        pthread_join(Threads[i], NULL);
+        Total += Lookups[i];
+    }
+
+    double Elapsed = nowSeconds() - Start;
+
+    pthread_join(WriterThread, NULL);
+
+    return Total / Elapsed;
+}
+
+int main(int argc, char **argv) {
+
+    if (argc > 1)
+        Size = atoi(argv[1]);
+
+    if (argc > 2)
+        Seconds = atof(argv[2]);
+
+    if (Size < 2) {
+        printf("Size must be at least 2\n");
+        return 1;
+    }
+
+    Concurrent = newConcurrentList();
+    Locked = newList();
+    Values = (void **) malloc(sizeof(void *) * Size);
+
+    for (int i = 0; i < Size; ++i) {
+        addToConcurrentList(Concurrent, Values[i] = newValue(i));
+        addToList(Locked, newValue(i));
+    }
+
+    printf("%d values, one write every %d us, %.1f s per run\n\n", Size, WRITE_EVERY_MICROS, Seconds);
+    printf("%8s %22s %22s %8s\n", "readers", "ConcurrentList (M/s)", "mutex + LinkedList (M/s)", "ratio");
+
+    for (int Readers = 1; Readers <= MAX_READERS; Readers *= 2) {
+
+        double Lockless = run(Readers, readConcurrent, writeConcurrent);
+        double Mutex = run(Readers, readLocked, writeLocked);
+
+        printf("%8d %22.2f %22.2f %8.2f\n", Readers, Lockless / 1e6, Mutex / 1e6, Lockless / Mutex);
+    }
+
+    deleteConcurrentList(Concurrent);
+    deleteList(Locked);
+    free(Values);
+
+    return 0;
+}
@@ -0,0 +1,243 @@
+/*
+
+    Fast Access List Benchmark
+
+    Runs the same operations on fast_access_list<int>, std::list<int> and std::deque<int>:
+     -  in order: reads every index, 0, 1, 2, ..., where the cursor makes every step one hop.
+     -  in order, const: the same through a const reference, which doesn't move the cursor.
+     -  random: reads at random indices.
+     -  editing: inserts and erases around a position drifting a few places at a time
+        (an editor's buffer), and reads next to it.
+     -  iterating: a range for over the whole list, no indices.
+     -  queue: push_back and pop_front.
+
+    std::list has no operator[], so it walks with std::next from begin() for every
+    index, which is what indexing a std::list means. std::deque has O(1) operator[],
+    but has to move up to half its elements for an insert or erase in the middle.
+
+    Build (from the repository root):
+        g++ -std=c++17 -O2 -I. bench/FastAccessListBench.cpp -o FastAccessListBench
+
+    Run:
+        ./FastAccessListBench [Size] [Operations]
+
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <iterator>
+#include <list>
+
+#include "FastAccessList.hpp"
+
+static std::size_t size = 10000;
+static std::size_t operations = 100000;
+
+// Keeps the reads from being optimized away
+static unsigned long long checksum;
+
+/*
+
+    Indexing, the same call for all three
+
+ */
+
+template<typename List>
+static int &element_at(List &list, std::size_t index) {
+    return list[index];
+}
+
+static int &element_at(std::list<int> &list, std::size_t index) {
+    return *std::next(list.begin(), static_cast<std::ptrdiff_t>(index));
+}
+
+template<typename List>
+static int element_at(const List &list, std::size_t index) {
+    return list[index];
+}
+
+static int element_at(const std::list<int> &list, std::size_t index) {
+    return *std::next(list.begin(), static_cast<std::ptrdiff_t>(index));
+}
+
+template<typename List>
+static void insert_at(List &list, std::size_t index, int value) {
+    list.insert(std::next(list.begin(), static_cast<std::ptrdiff_t>(index)), value);
+}
+
+static void insert_at(fast_access_list<int> &list, std::size_t index, int value) {
+    list.emplace_at(index, value);
+}
+
+template<typename List>
+static void erase_at(List &list, std::size_t index) {
+    list.erase(std::next(list.begin(), static_cast<std::ptrdiff_t>(index)));
+}
+
+static void erase_at(fast_access_list<int> &list, std::size_t index) {
+    list.erase_at(index);
+}
+
+// xorshift64, every list gets the same numbers
+struct random_numbers {
+
+    unsigned long long seed = 88172645463325252ULL;
+
+    std::size_t next() {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        return static_cast<std::size_t>(seed >> 32);
+    }
+};
+
+/*
+
+    Workloads
+
+    Each gets a list of size elements, and returns nanoseconds per operation.
+
+ */
+
+template<typename List, typename Work>
+static double measure(Work work) {
+
+    List list;
+
+    for (std::size_t i = 0; i < size; ++i)
+        list.push_back(static_cast<int>(i));
+
+    auto start = std::chrono::steady_clock::now();
+    std::size_t done = work(list);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(done);
+}
+
+template<typename List>
+static std::size_t in_order(List &list) {
+
+    std::size_t done = 0;
+
+    while (done < operations)
+        for (std::size_t i = 0; i < size && done < operations; ++i, ++done)
+            checksum += static_cast<unsigned>(element_at(list, i));
+
+    return done;
+}
+
+template<typename List>
+static std::size_t in_order_const(const List &list) {
+
+    std::size_t done = 0;
+
+    while (done < operations)
+        for (std::size_t i = 0; i < size && done < operations; ++i, ++done)
+            checksum += static_cast<unsigned>(element_at(list, i));
+
+    return done;
+}
+
+template<typename List>
+static std::size_t random_reads(List &list) {
+
+    random_numbers numbers;
+
+    for (std::size_t i = 0; i < operations; ++i)
+        checksum += static_cast<unsigned>(element_at(list, numbers.next() % size));
+
+    return operations;
+}
+
+template<typename List>
+static std::size_t editing(List &list) {
+
+    random_numbers numbers;
+    std::size_t position = size / 2;
+
+    for (std::size_t i = 0; i < operations; ++i) {
+
+        // Drift a few places, and stay in the middle half of the list
+        position = position + numbers.next() % 9 - 4;
+        position = std::min(std::max(position, size / 4), size * 3 / 4);
+
+        // Inserts and erases take turns, so the list stays at size elements
+        std::size_t dice = numbers.next() % 10;
+
+        if (dice == 0)
+            checksum += static_cast<unsigned>(element_at(list, position));
+        else if (list.size() <= size)
+            insert_at(list, position, static_cast<int>(i));
+        else
+            erase_at(list, position);
+    }
+
+    return operations;
+}
+
+template<typename List>
+static std::size_t iterating(List &list) {
+
+    std::size_t done = 0;
+
+    while (done < operations) {
+        for (int value : list)
+            checksum += static_cast<unsigned>(value);
+        done += size;
+    }
+
+    return done;
+}
+
+template<typename List>
+static std::size_t queue(List &list) {
+
+    for (std::size_t i = 0; i < operations; ++i) {
+        list.push_back(static_cast<int>(i));
+        checksum += static_cast<unsigned>(list.front());
+        list.pop_front();
+    }
+
+    return operations;
+}
+
+template<typename Work>
+static void run(const char *name, Work work) {
+
+    double fast = measure<fast_access_list<int>>([&](fast_access_list<int> &list) { return work(list); });
+    double list = measure<std::list<int>>([&](std::list<int> &list) { return work(list); });
+    double deque = measure<std::deque<int>>([&](std::deque<int> &list) { return work(list); });
+
+    std::printf("%-16s %18.2f %14.2f %14.2f\n", name, fast, list, deque);
+}
+
+int main(int argc, char **argv) {
+
+    if (argc > 1)
+        size = static_cast<std::size_t>(std::atol(argv[1]));
+
+    if (argc > 2)
+        operations = static_cast<std::size_t>(std::atol(argv[2]));
+
+    if (size < 4) {
+        std::printf("Size must be at least 4\n");
+        return 1;
+    }
+
+    std::printf("%zu elements, %zu operations\n\n", size, operations);
+    std::printf("%-16s %18s %14s %14s\n", "ns / op", "fast_access_list", "std::list", "std::deque");
+
+    run("in order", [](auto &list) { return in_order(list); });
+    run("in order, const", [](auto &list) { return in_order_const(list); });
+    run("random", [](auto &list) { return random_reads(list); });
+    run("editing", [](auto &list) { return editing(list); });
+    run("iterating", [](auto &list) { return iterating(list); });
+    run("queue", [](auto &list) { return queue(list); });
+
+    std::printf("\n(checksum %llu)\n", checksum);
+
+    return 0;
+}
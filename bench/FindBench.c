@@ -0,0 +1,176 @@
+/*
+    Find Benchmark
+
+    Looks for the last value of a list, over and over, in a few ways:
+     -  forEachElementInList with a callback comparing every value, what you'd write without find.
+     -  findValueInList, comparing pointers.
+     -  findKeyInList, comparing an int inside every value.
+     -  findValueInList and findKeyInList again, once Adaptive Storage has moved the values into an array.
+
+    Build it twice (from the repository root), to compare the SIMD kernels with the scalar ones:
+        gcc -O2 -pthread -I. bench/FindBench.c LinkedList.c -o FindBench
+        gcc -O2 -pthread -I. -DLINKEDLIST_NO_SIMD bench/FindBench.c LinkedList.c -o FindBenchScalar
+
+    Run:
+        ./FindBench
+        ./FindBenchScalar
+
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <time.h>
+
+#include "LinkedList.h"
+
+// Every size is searched until about this many values were compared
+#define VALUES_PER_SIZE 100000000LL
+
+// A value with an int key inside, like most structs kept in a list
+typedef struct Record {
+
+    double Weight;
+
+    int Key;
+
+} Record;
+
+// What the callback scan looks for, and what it found
+static void *Target;
+static int TargetKey;
+static int Visited;
+static int FoundAt;
+
+static double nowSeconds() {
+
+    struct timespec Now;
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+
+    return Now.tv_sec + Now.tv_nsec / 1e9;
+}
+
+static void compareValue(void *Value) {
+
+    if (Value == Target && FoundAt < 0)
+        FoundAt = Visited;
+
+    Visited++;
+}
+
+static void compareKey(void *Value) {
+
+    if (((Record *) Value)->Key == TargetKey && FoundAt < 0)
+        FoundAt = Visited;
+
+    Visited++;
+}
+
+static int callbackFindValue(LinkedList *list, void *Value) {
+
+    Target = Value;
+    Visited = 0;
+    FoundAt = -1;
+
+    forEachElementInList(list, compareValue);
+
+    return FoundAt;
+}
+
+static int callbackFindKey(LinkedList *list, int Key) {
+
+    TargetKey = Key;
+    Visited = 0;
+    FoundAt = -1;
+
+    forEachElementInList(list, compareKey);
+
+    return FoundAt;
+}
+
+/*
+
+    Each run returns nanoseconds per value compared, and checks the answer.
+
+ */
+
+#define MEASURE(Call)                                                   \
+    do {                                                                \
+        double Start = nowSeconds();                                    \
+        for (long long r = 0; r < Repeat; ++r)                          \
+            if ((Call) != Expected) {                                   \
+                printf("WRONG ANSWER FROM %s\n", #Call);                \
+                exit(1);                                                \
+            }                                                           \
+        Nanos = (nowSeconds() - Start) * 1e9 / ((double) Repeat * Size);  \
+    } while (0)
+
+int main() {
+
+#ifdef LINKEDLIST_NO_SIMD
+    printf("kernels: scalar (LINKEDLIST_NO_SIMD)\n\n");
+#else
+    printf("kernels: picked at runtime (SSE2 / AVX2 when available)\n\n");
+#endif
+
+    printf("%10s %14s %14s %14s %14s %14s %14s\n", "size", "callback ptr", "findValue", "callback key", "findKey",
+           "findValue arr", "findKey arr");
+    printf("%10s %14s %14s %14s %14s %14s %14s\n", "", "ns/value", "ns/value", "ns/value", "ns/value", "ns/value",
+           "ns/value");
+
+    int Sizes[] = {1000, 64000, 1000000};
+
+    for (int s = 0; s < 3; ++s) {
+
+        int Size = Sizes[s];
+        long long Repeat = VALUES_PER_SIZE / Size;
+
+        LinkedList *list = newList();
+
+        for (int i = 0; i < Size; ++i) {
+            Record *record = (Record *) malloc(sizeof(struct Record));
+            record->Weight = i;
+            record->Key = i;
+            addToList(list, record);
+        }
+
+        // The last one, so every way has to look at everything
+        int Expected = Size - 1;
+        void *Last = getFromList(list, Expected);
+
+        double Nanos, CallbackValue, FindValue, CallbackKey, FindKey, FindValueArray, FindKeyArray;
+
+        MEASURE(callbackFindValue(list, Last));
+        CallbackValue = Nanos;
+
+        MEASURE(findValueInList(list, Last));
+        FindValue = Nanos;
+
+        MEASURE(callbackFindKey(list, Expected));
+        CallbackKey = Nanos;
+
+        MEASURE(findKeyInList(list, offsetof(Record, Key), Expected));
+        FindKey = Nanos;
+
+        // Random reads until the list moves its values into an array
+        enableListAdaptiveStorage(list);
+
+        for (int i = 0; !isListStoredAsArray(list) && i < 100 * Size; ++i)
+            getFromList(list, (int) ((i * 2654435761u) % (unsigned) Size));
+
+        MEASURE(findValueInList(list, Last));
+        FindValueArray = Nanos;
+
+        MEASURE(findKeyInList(list, offsetof(Record, Key), Expected));
+        FindKeyArray = Nanos;
+
+        printf("%10d %14.3f %14.3f %14.3f %14.3f %14.3f %14.3f%s\n", Size, CallbackValue, FindValue, CallbackKey,
+               FindKey, FindValueArray, FindKeyArray, isListStoredAsArray(list) ? "" : " (still nodes)");
+
+        deleteList(list);
+    }
+
+    return 0;
+}
@@ -0,0 +1,225 @@
+/*
+    Sharded List Benchmark
+
+    Appends Items values from 1 to 16 threads, two ways:
+     -  ShardedList, with a shard per thread.
+     -  LinkedList behind one mutex, what you have to do without it.
+
+    Before that, it checks what ShardedList promises, and stops if it doesn't hold:
+    every thread appends to two lists in turn, with other lists created in between,
+    and after collecting, every thread's values must be in order, in one run each,
+    since every thread must have kept its own shard of each list.
+    Every timed ShardedList run is checked the same way.
+
+    Build (from the repository root):
+        gcc -O2 -pthread -I. bench/ShardedListBench.c ShardedList.c LinkedList.c -o ShardedListBench
+
+    Run:
+        ./ShardedListBench [Items]
+
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "ShardedList.h"
+#include "LinkedList.h"
+
+// Most threads appending at once
+#define MAX_THREADS 16
+
+// Values are (thread << VALUE_BITS) + number, so a thread appends fewer than this many
+#define VALUE_BITS 24
+
+// Lists created between the two lists of the check. Threads used to remember their
+// shard of 16 lists, by list number modulo 16, so these two would take the same place
+#define OTHER_LISTS 15
+
+static int Items = 4000000;
+static int Threads;
+
+static ShardedList *Sharded;
+static ShardedList *SecondSharded;
+
+static LinkedList *Locked;
+static pthread_mutex_t LockedLock = PTHREAD_MUTEX_INITIALIZER;
+
+static double nowSeconds() {
+
+    struct timespec Now;
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+
+    return Now.tv_sec + Now.tv_nsec / 1e9;
+}
+
+static void *valueOf(long Thread, int Number) {
+    return (void *) (intptr_t) ((Thread << VALUE_BITS) + Number + 1);
+}
+
+/*
+
+    Threads
+
+ */
+
+static void *appendSharded(void *Argument) {
+
+    long Id = (long) Argument;
+
+    for (int i = 0; i < Items / Threads; ++i)
+        addToShardedList(Sharded, valueOf(Id, i));
+
+    return NULL;
+}
+
+// Appends to both lists in turn
+static void *appendAlternating(void *Argument) {
+
+    long Id = (long) Argument;
+
+    for (int i = 0; i < Items / Threads; ++i)
+        addToShardedList(i % 2 == 0 ? Sharded : SecondSharded, valueOf(Id, i));
+
+    return NULL;
+}
+
+static void *appendLocked(void *Argument) {
+
+    long Id = (long) Argument;
+
+    for (int i = 0; i < Items / Threads; ++i) {
+        pthread_mutex_lock(&LockedLock);
+        addToList(Locked, valueOf(Id, i));
+        pthread_mutex_unlock(&LockedLock);
+    }
+
+    return NULL;
+}
+
+/*
+
+    static double run(void *(*Append)(void *))
+
+    Runs Threads threads, returns how long they took in seconds.
+
+ */
+
+static double run(void *(*Append)(void *)) {
+
+    pthread_t AppendThreads[MAX_THREADS];
+
+    double Start = nowSeconds();
+
+    for (long i = 0; i < Threads; ++i)
+        pthread_create(&AppendThreads[i], NULL, Append, (void *) i);
+
+    for (int i = 0; i < Threads; ++i)
+        pthread_join(AppendThreads[i], NULL);
+
+    return nowSeconds() - Start;
+}
+
+/*
+
+    static void check(ShardedList *list, const char *Name)
+
+    Collects the list, and stops unless every thread's values are in order,
+    and each thread's values come in one run (it had a shard of its own).
+    The values are just numbers, so nothing is freed but the nodes.
+
+ */
+
+static void check(ShardedList *list, const char *Name) {
+
+    LinkedList *Collected = collectShardedList(list);
+
+    intptr_t Last[MAX_THREADS];
+    int Runs = 0;
+    long Previous = -1;
+
+    for (int i = 0; i < MAX_THREADS; ++i)
+        Last[i] = 0;
+
+    for (int i = 0; i < getListSize(Collected); ++i) {
+
+        intptr_t Value = (intptr_t) getFromList(Collected, i);
+        long Thread = (long) (Value >> VALUE_BITS);
+
+        if (Value <= Last[Thread]) {
+            printf("WRONG ORDER IN %s: THREAD %ld APPENDED %ld AFTER %ld\n", Name, Thread,
+                   (long) (Value & ((1 << VALUE_BITS) - 1)), (long) (Last[Thread] & ((1 << VALUE_BITS) - 1)));
+            exit(1);
+        }
+
+        Last[Thread] = Value;
+
+        if (Thread != Previous) {
+            Runs++;
+            Previous = Thread;
+        }
+    }
+
+    if (Runs != Threads) {
+        printf("SHARED SHARDS IN %s: %d RUNS FOR %d THREADS\n", Name, Runs, Threads);
+        exit(1);
+    }
+
+    deleteListKeepValues(Collected);
+}
+
+int main(int argc, char **argv) {
+
+    if (argc > 1)
+        Items = atoi(argv[1]);
+
+    if (Items / MAX_THREADS < 1 || Items >= (1 << VALUE_BITS)) {
+        printf("Items must be between %d and %d\n", MAX_THREADS, (1 << VALUE_BITS) - 1);
+        return 1;
+    }
+
+    // Two lists, with others made in between, used in turn by every thread
+    Threads = 4;
+    Sharded = newShardedList(Threads);
+
+    ShardedList *Others[OTHER_LISTS];
+    for (int i = 0; i < OTHER_LISTS; ++i)
+        Others[i] = newShardedList(1);
+
+    SecondSharded = newShardedList(Threads);
+
+    run(appendAlternating);
+    check(Sharded, "FIRST LIST");
+    check(SecondSharded, "SECOND LIST");
+
+    for (int i = 0; i < OTHER_LISTS; ++i)
+        deleteShardedList(Others[i]);
+
+    deleteShardedList(Sharded);
+    deleteShardedList(SecondSharded);
+
+    printf("%d items, checked: every thread keeps its shard, across lists\n\n", Items);
+    printf("%8s %22s %24s %8s\n", "threads", "ShardedList (M/s)", "mutex + LinkedList (M/s)", "ratio");
+
+    for (Threads = 1; Threads <= MAX_THREADS; Threads *= 2) {
+
+        Sharded = newShardedList(Threads);
+        Locked = newList();
+
+        double ShardedRate = Items / Threads * Threads / run(appendSharded);
+        double LockedRate = Items / Threads * Threads / run(appendLocked);
+
+        check(Sharded, "TIMED RUN");
+
+        printf("%8d %22.2f %24.2f %8.2f\n", Threads, ShardedRate / 1e6, LockedRate / 1e6, ShardedRate / LockedRate);
+
+        deleteShardedList(Sharded);
+        deleteListKeepValues(Locked);
+    }
+
+    return 0;
+}